@@ -35,11 +35,47 @@ and correct management of thread and resource life cycles (RAII).
 #include <iostream>
 #include <variant>
 #include <queue>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
 #include <condition_variable>
 #include <thread>
 #include <functional>
 #include <atomic>
 #include <map>
+#include <memory>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <span>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+#if defined(__linux__)
+#include <cerrno>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 /**
  * I have tried to explain everything via the comments and self-describing variable names or such.
@@ -61,38 +97,256 @@ struct NetworkDataEvent { std::vector<uint8_t> data; };
 // Since RTTI is not allowed, we can use std::variant to hold different event types in a type-safe manner.
 using Event = std::variant<std::monostate, UserInputEvent, NetworkDataEvent>;
 
+// Names for reports, indexed like Event
+constexpr std::array<std::string_view, std::variant_size_v<Event>> EVENT_TYPE_NAMES = {
+    "monostate", "UserInputEvent", "NetworkDataEvent"
+};
+
+using Clock = std::chrono::steady_clock;
+
+// Metrics (opt-in) - Reading the clock costs ~20-40ns, a few percent of a
+// whole post-and-dispatch, so only one event in this many is timed. Counts
+// and queue depths are still exact. Set to 1 to time every event.
+constexpr uint32_t METRICS_SAMPLE_RATE = 8;
+static_assert(std::has_single_bit(METRICS_SAMPLE_RATE));
+
+// Picks events to time at random rather than every Nth, which would alias
+// with any regular posting pattern (e.g. always the same event type)
+inline bool sampleThisEvent() {
+    thread_local uint32_t state =
+        0x9E3779B9u ^ static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return (state & (METRICS_SAMPLE_RATE - 1)) == 0;
+}
+
+// Metrics (opt-in) - Adds to a counter that has one writer at a time. A
+// relaxed load and store is enough and, unlike fetch_add, needs no locked
+// instruction; readers on other threads still see whole values.
+inline void bump(std::atomic<uint64_t>& counter, uint64_t n = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+// Metrics (opt-in) - Log-linear latency histogram, HDR style
+// Values below 16ns get their own bucket; above that every power of two is
+// split into 16 linear sub-buckets, so any recorded value is reported within
+// 1/16 (~6%) of its true value. Lock-free: one thread records (the worker)
+// while any thread reads a summary.
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BITS = 4;
+    static constexpr uint64_t SUB_COUNT = 1u << SUB_BITS;
+    static constexpr unsigned MAX_SHIFT = 36;  // Up to ~2^40 ns (18 minutes)
+    static constexpr size_t BUCKETS = (MAX_SHIFT + 2) * SUB_COUNT;
+
+    struct Summary {
+        uint64_t count = 0;
+        std::chrono::nanoseconds mean{}, p50{}, p99{}, p999{}, max{};
+    };
+
+    void record(std::chrono::nanoseconds d) {
+        const auto ns = static_cast<uint64_t>(std::max<int64_t>(d.count(), 0));
+        bump(m_counts[bucketOf(ns)]);
+        bump(m_count);
+        bump(m_sum, ns);
+        if (ns > m_max.load(std::memory_order_relaxed)) m_max.store(ns, std::memory_order_relaxed);
+    }
+
+    // Upper edge of the bucket holding the q-th quantile, capped at the max
+    std::chrono::nanoseconds percentile(double q) const {
+        const uint64_t total = m_count.load(std::memory_order_relaxed);
+        if (total == 0) return {};
+        const auto rank = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t b = 0; b < BUCKETS; ++b) {
+            seen += m_counts[b].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                return std::chrono::nanoseconds(
+                    static_cast<int64_t>(std::min(bucketUpperEdge(b), m_max.load(std::memory_order_relaxed))));
+            }
+        }
+        return std::chrono::nanoseconds(static_cast<int64_t>(m_max.load(std::memory_order_relaxed)));
+    }
+
+    // Adds other's samples to ours; the caller must be this histogram's only writer
+    void merge(const LatencyHistogram& other) {
+        for (size_t b = 0; b < BUCKETS; ++b) bump(m_counts[b], other.m_counts[b].load(std::memory_order_relaxed));
+        bump(m_count, other.m_count.load(std::memory_order_relaxed));
+        bump(m_sum, other.m_sum.load(std::memory_order_relaxed));
+        const uint64_t otherMax = other.m_max.load(std::memory_order_relaxed);
+        if (otherMax > m_max.load(std::memory_order_relaxed)) m_max.store(otherMax, std::memory_order_relaxed);
+    }
+
+    Summary summary() const {
+        Summary s;
+        s.count = m_count.load(std::memory_order_relaxed);
+        if (s.count == 0) return s;
+        s.mean = std::chrono::nanoseconds(static_cast<int64_t>(m_sum.load(std::memory_order_relaxed) / s.count));
+        s.p50 = percentile(0.50);
+        s.p99 = percentile(0.99);
+        s.p999 = percentile(0.999);
+        s.max = std::chrono::nanoseconds(static_cast<int64_t>(m_max.load(std::memory_order_relaxed)));
+        return s;
+    }
+
+private:
+    static size_t bucketOf(uint64_t ns) {
+        if (ns < SUB_COUNT) return static_cast<size_t>(ns);
+        const unsigned shift = std::min<unsigned>(static_cast<unsigned>(std::bit_width(ns)) - 1 - SUB_BITS, MAX_SHIFT);
+        const uint64_t sub = std::min<uint64_t>(ns >> shift, 2 * SUB_COUNT - 1) - SUB_COUNT;
+        return static_cast<size_t>((shift + 1) * SUB_COUNT + sub);
+    }
+
+    static uint64_t bucketUpperEdge(size_t b) {
+        if (b < SUB_COUNT) return b;
+        const uint64_t shift = b / SUB_COUNT - 1;
+        return ((SUB_COUNT + b % SUB_COUNT + 1) << shift) - 1;
+    }
+
+    std::array<std::atomic<uint64_t>, BUCKETS> m_counts{};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sum{0};
+    std::atomic<uint64_t> m_max{0};
+};
+
+// Metrics (opt-in) - Queue-level counters. Written under the queue mutex
+// (so one writer at a time), read lock-free by snapshots.
+struct QueueMetrics {
+    struct Snapshot {
+        uint64_t pushed = 0, popped = 0;
+        size_t depth = 0, highWater = 0;
+        double averageDepth = 0;  // Depth seen by arriving items
+        std::chrono::nanoseconds producerBlocked{}, consumerIdle{};
+    };
+
+    std::atomic<uint64_t> pushed{0};
+    std::atomic<uint64_t> popped{0};
+    std::atomic<uint64_t> depth{0};
+    std::atomic<uint64_t> highWater{0};
+    std::atomic<uint64_t> depthSum{0};
+    std::atomic<uint64_t> producerBlockedNs{0};
+    std::atomic<uint64_t> consumerIdleNs{0};
+
+    Snapshot snapshot() const {
+        Snapshot s;
+        s.pushed = pushed.load(std::memory_order_relaxed);
+        s.popped = popped.load(std::memory_order_relaxed);
+        s.depth = static_cast<size_t>(depth.load(std::memory_order_relaxed));
+        s.highWater = static_cast<size_t>(highWater.load(std::memory_order_relaxed));
+        s.averageDepth = s.pushed ? static_cast<double>(depthSum.load(std::memory_order_relaxed)) /
+                                        static_cast<double>(s.pushed)
+                                  : 0.0;
+        const auto ns = [](const std::atomic<uint64_t>& v) {
+            return std::chrono::nanoseconds(static_cast<int64_t>(v.load(std::memory_order_relaxed)));
+        };
+        s.producerBlocked = ns(producerBlockedNs);
+        s.consumerIdle = ns(consumerIdleNs);
+        return s;
+    }
+};
+
+// Timers - Why BoundedQueue::popUntil returned
+enum class PopResult { Item, Timeout, Closed };
+
 // #REQ 2 - Thread-Safe Bounded Queue (Simulating ETL circular buffer concepts)
 template <typename T, size_t Capacity>
 class BoundedQueue {
 public:
+    // Metrics (opt-in) - Counters are only touched once attached; call before use
+    void attachMetrics(QueueMetrics* metrics) { m_metrics = metrics; }
+
     // #REQ 2.a - Push item into the queue, blocks if full
     void push(T item) {
+        // Sampled items carry their post time. It is read before locking to
+        // keep the clock out of the critical section, so enqueue-to-dispatch
+        // latency includes any time blocked here. Unsampled items carry 0.
+        const auto postedAt = m_metrics && sampleThisEvent() ? Clock::now() : Clock::time_point{};
         std::unique_lock<std::mutex> lock(m_mutex);
         // Wait until there is space or we are shutting down
         auto untilEnoughSpace = [this]{ return m_queue.size() < Capacity || m_shutdown; };
-        m_not_full.wait(lock, untilEnoughSpace);
+        if (m_metrics && !untilEnoughSpace()) {
+            // Blocking is the slow path anyway: always timed
+            const auto blockedAt = postedAt != Clock::time_point{} ? postedAt : Clock::now();
+            m_not_full.wait(lock, untilEnoughSpace);
+            bump(m_metrics->producerBlockedNs, static_cast<uint64_t>((Clock::now() - blockedAt).count()));
+        } else {
+            m_not_full.wait(lock, untilEnoughSpace);
+        }
         
         if (m_shutdown) return;
 
-        m_queue.push(std::move(item));
+        m_queue.push(Slot{std::move(item), postedAt});
+        if (m_metrics) recordDepth(true);
         m_not_empty.notify_one(); // Notify one waiting consumer
     }
 
     // #REQ 2.b - Pop item from the queue, blocks if empty
     bool pop(T& item) {
+        Clock::time_point enqueuedAt;
+        return pop(item, enqueuedAt);
+    }
+
+    // Also reports when a sampled item was pushed (epoch for the others)
+    bool pop(T& item, Clock::time_point& enqueuedAt) {
         std::unique_lock<std::mutex> lock(m_mutex);
         // Wait until data exists or shutdown signal
         auto untilDataOrShutdown = [this]{ return !m_queue.empty() || m_shutdown; };
-        m_not_empty.wait(lock, untilDataOrShutdown);
+        if (m_metrics && !untilDataOrShutdown()) {
+            const auto idleAt = Clock::now();
+            m_not_empty.wait(lock, untilDataOrShutdown);
+            bump(m_metrics->consumerIdleNs, static_cast<uint64_t>((Clock::now() - idleAt).count()));
+        } else {
+            m_not_empty.wait(lock, untilDataOrShutdown);
+        }
 
         if (m_queue.empty() && m_shutdown) return false;
 
-        item = std::move(m_queue.front());
+        item = std::move(m_queue.front().item);
+        enqueuedAt = m_queue.front().enqueuedAt;
         m_queue.pop();
+        if (m_metrics) recordDepth(false);
         m_not_full.notify_one();
         return true;
     }
 
+    // Timers - Like pop, but also returns at the deadline or when interrupt()
+    // is called, so the worker can wake up for timers between events
+    PopResult popUntil(T& item, Clock::time_point& enqueuedAt, Clock::time_point deadline) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto untilDataShutdownOrInterrupt = [this]{ return !m_queue.empty() || m_shutdown || m_interrupted; };
+        auto wait = [&] {
+            if (deadline == Clock::time_point::max()) m_not_empty.wait(lock, untilDataShutdownOrInterrupt);
+            else m_not_empty.wait_until(lock, deadline, untilDataShutdownOrInterrupt);
+        };
+        if (m_metrics && !untilDataShutdownOrInterrupt()) {
+            const auto idleAt = Clock::now();
+            wait();
+            bump(m_metrics->consumerIdleNs, static_cast<uint64_t>((Clock::now() - idleAt).count()));
+        } else {
+            wait();
+        }
+        m_interrupted = false;
+
+        if (m_queue.empty()) return m_shutdown ? PopResult::Closed : PopResult::Timeout;
+
+        item = std::move(m_queue.front().item);
+        enqueuedAt = m_queue.front().enqueuedAt;
+        m_queue.pop();
+        if (m_metrics) recordDepth(false);
+        m_not_full.notify_one();
+        return PopResult::Item;
+    }
+
+    // Timers - Makes a waiting (or the next) popUntil return early
+    void interrupt() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_interrupted = true;
+        }
+        m_not_empty.notify_all();
+    }
+
     // #REQ 2.c - Signal no more event will be added, unblock waiting threads
     void shutdown() {
         {
@@ -105,11 +359,241 @@ public:
     }
 
 private:
-    std::queue<T> m_queue; // etl::queue not available
+    struct Slot {
+        T item;
+        Clock::time_point enqueuedAt;
+    };
+
+    // Called with m_mutex held
+    void recordDepth(bool pushed) {
+        const uint64_t depth = m_queue.size();
+        m_metrics->depth.store(depth, std::memory_order_relaxed);
+        if (pushed) {
+            bump(m_metrics->pushed);
+            bump(m_metrics->depthSum, depth);
+            if (depth > m_metrics->highWater.load(std::memory_order_relaxed))
+                m_metrics->highWater.store(depth, std::memory_order_relaxed);
+        } else {
+            bump(m_metrics->popped);
+        }
+    }
+
+    std::queue<Slot> m_queue; // etl::queue not available
+    QueueMetrics* m_metrics = nullptr;
     std::mutex m_mutex; // For thread-safe queue
     std::condition_variable m_not_empty;
     std::condition_variable m_not_full;
     bool m_shutdown = false;
+    bool m_interrupted = false;
+};
+
+// Timers - Hierarchical hashed timing wheel (Varghese & Lauck; the Linux kernel's design)
+// Level 0 has 256 slots of one tick each. Every level above has 64 slots, each
+// as wide as a whole turn of the level below, so five levels reach 2^32 ticks
+// (~50 days at 1ms). A timer is hashed into a slot by its expiry tick; each time
+// a level completes a turn, the next slot of the level above is cascaded down.
+// Insert and cancel are O(1) (amortised over the pool growing): timers are
+// pooled nodes in doubly-linked slot lists, linked by index to keep them small.
+// Advancing skips empty level-0 slots with a bitmap. Not thread-safe.
+template <typename T>
+class TimingWheel {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    // Index into the pool plus a generation, so a stale id cannot cancel the
+    // timer that later reuses the node
+    struct TimerId {
+        uint32_t index = NONE;
+        uint32_t generation = 0;
+    };
+
+    explicit TimingWheel(uint64_t startTick = 0) : m_tick(startTick) { m_heads.fill(NONE); }
+
+    // periodTicks is 0 for a one-shot timer. A tick already passed fires on the next one.
+    TimerId schedule(uint64_t expiresTick, uint64_t periodTicks, T payload) {
+        uint32_t index = m_freeHead;
+        if (index != NONE) {
+            m_freeHead = m_nodes[index].next;
+        } else {
+            index = static_cast<uint32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+        }
+        Node& node = m_nodes[index];
+        node.payload = std::move(payload);
+        node.expires = expiresTick;
+        node.period = periodTicks;
+        link(index);
+        ++m_size;
+        return {index, node.generation};
+    }
+
+    // False if the timer already fired (one-shot) or was cancelled
+    bool cancel(TimerId id) {
+        if (id.index >= m_nodes.size()) return false;
+        const Node& node = m_nodes[id.index];
+        if (node.generation != id.generation || node.bucket == NONE) return false;
+        unlink(id.index);
+        release(id.index);
+        return true;
+    }
+
+    // Moves time forward to nowTick, calling onExpired(T& payload, bool lastTime)
+    // for every timer due on the way. Periodic timers are re-armed; if they fell
+    // behind by whole periods the missed firings are skipped, not replayed.
+    template <typename F>
+    void advance(uint64_t nowTick, F&& onExpired) {
+        while (m_tick < nowTick) {
+            if (m_size == 0) {
+                m_tick = nowTick;
+                break;
+            }
+            const uint64_t next = nextWorkTick();
+            if (next > nowTick) {
+                m_tick = nowTick;
+                break;
+            }
+            m_tick = next;
+            if ((m_tick & L0_MASK) == 0) cascade();
+            expire(static_cast<uint32_t>(m_tick & L0_MASK), onExpired);
+        }
+    }
+
+    // Earliest tick at which advance() has work to do (an expiry or a cascade)
+    std::optional<uint64_t> nextTick() const {
+        if (m_size == 0) return std::nullopt;
+        return nextWorkTick();
+    }
+
+    size_t size() const { return m_size; }
+    uint64_t currentTick() const { return m_tick; }
+
+private:
+    static constexpr unsigned LEVELS = 5;
+    static constexpr unsigned L0_BITS = 8;
+    static constexpr unsigned LN_BITS = 6;
+    static constexpr uint32_t L0_SLOTS = 1u << L0_BITS;
+    static constexpr uint32_t LN_SLOTS = 1u << LN_BITS;
+    static constexpr uint64_t L0_MASK = L0_SLOTS - 1;
+    static constexpr uint64_t LN_MASK = LN_SLOTS - 1;
+    static constexpr uint32_t BUCKETS = L0_SLOTS + (LEVELS - 1) * LN_SLOTS;
+
+    // Ticks covered by one slot of a level above 0
+    static constexpr unsigned shiftOf(unsigned level) { return L0_BITS + (level - 1) * LN_BITS; }
+    static constexpr uint64_t MAX_DELTA = (uint64_t{1} << shiftOf(LEVELS)) - 1;
+
+    struct Node {
+        T payload{};
+        uint64_t expires = 0;
+        uint64_t period = 0;
+        uint32_t prev = NONE;
+        uint32_t next = NONE;      // Also links the free list
+        uint32_t generation = 0;
+        uint32_t bucket = NONE;    // NONE while free
+    };
+
+    void link(uint32_t index) {
+        Node& node = m_nodes[index];
+        const uint64_t due = std::max(node.expires, m_tick + 1);
+        // Beyond the top level: parked at its far end and re-hashed on the way down
+        const uint64_t delta = std::min(due - m_tick, MAX_DELTA);
+        uint32_t bucket;
+        if (delta < L0_SLOTS) {
+            bucket = static_cast<uint32_t>(due & L0_MASK);
+            m_occupied[bucket / 64] |= uint64_t{1} << (bucket % 64);
+        } else {
+            unsigned level = 1;
+            while (level < LEVELS - 1 && delta >= (uint64_t{1} << shiftOf(level + 1))) ++level;
+            const uint64_t at = m_tick + delta;
+            bucket = L0_SLOTS + (level - 1) * LN_SLOTS + static_cast<uint32_t>((at >> shiftOf(level)) & LN_MASK);
+        }
+        node.bucket = bucket;
+        node.prev = NONE;
+        node.next = m_heads[bucket];
+        if (node.next != NONE) m_nodes[node.next].prev = index;
+        m_heads[bucket] = index;
+    }
+
+    void unlink(uint32_t index) {
+        Node& node = m_nodes[index];
+        if (node.prev != NONE) m_nodes[node.prev].next = node.next;
+        else m_heads[node.bucket] = node.next;
+        if (node.next != NONE) m_nodes[node.next].prev = node.prev;
+        if (node.bucket < L0_SLOTS && m_heads[node.bucket] == NONE) {
+            m_occupied[node.bucket / 64] &= ~(uint64_t{1} << (node.bucket % 64));
+        }
+        node.bucket = NONE;
+    }
+
+    void release(uint32_t index) {
+        Node& node = m_nodes[index];
+        node.payload = T{};  // Free whatever the payload holds now, not when reused
+        ++node.generation;
+        node.bucket = NONE;
+        node.next = m_freeHead;
+        m_freeHead = index;
+        --m_size;
+    }
+
+    // Detaches a whole slot list and returns its head
+    uint32_t takeBucket(uint32_t bucket) {
+        const uint32_t head = m_heads[bucket];
+        m_heads[bucket] = NONE;
+        if (bucket < L0_SLOTS) m_occupied[bucket / 64] &= ~(uint64_t{1} << (bucket % 64));
+        return head;
+    }
+
+    // Level 0 just wrapped: re-hash the next slot of level 1, and of each
+    // level above for as long as the one below it wrapped too
+    void cascade() {
+        for (unsigned level = 1; level < LEVELS; ++level) {
+            const auto slot = static_cast<uint32_t>((m_tick >> shiftOf(level)) & LN_MASK);
+            uint32_t index = takeBucket(L0_SLOTS + (level - 1) * LN_SLOTS + slot);
+            while (index != NONE) {
+                const uint32_t next = m_nodes[index].next;
+                link(index);
+                index = next;
+            }
+            if (slot != 0) break;
+        }
+    }
+
+    template <typename F>
+    void expire(uint32_t slot, F& onExpired) {
+        uint32_t index = takeBucket(slot);
+        while (index != NONE) {
+            Node& node = m_nodes[index];
+            const uint32_t next = node.next;
+            if (node.expires > m_tick) {
+                link(index);  // Was parked beyond the top level
+            } else if (node.period == 0) {
+                onExpired(node.payload, true);
+                release(index);
+            } else {
+                onExpired(node.payload, false);
+                node.expires += node.period;
+                if (node.expires <= m_tick) node.expires = m_tick + node.period;
+                link(index);
+            }
+            index = next;
+        }
+    }
+
+    // Next occupied level-0 slot in this turn, else the start of the next turn
+    uint64_t nextWorkTick() const {
+        const uint64_t turn = m_tick & ~L0_MASK;
+        for (uint32_t from = static_cast<uint32_t>(m_tick & L0_MASK) + 1; from < L0_SLOTS; from = (from | 63) + 1) {
+            const uint64_t bits = m_occupied[from / 64] >> (from % 64);
+            if (bits) return turn + from + static_cast<uint64_t>(std::countr_zero(bits));
+        }
+        return turn + L0_SLOTS;
+    }
+
+    std::vector<Node> m_nodes;
+    uint32_t m_freeHead = NONE;
+    std::array<uint32_t, BUCKETS> m_heads;
+    std::array<uint64_t, L0_SLOTS / 64> m_occupied{};
+    uint64_t m_tick;
+    size_t m_size = 0;
 };
 
 // Helper for std::visit
@@ -124,6 +608,357 @@ template<class... Ts> overloaded(Ts...) -> overloaded<Ts...>;
 
 // I dont like magic numbers
 constexpr size_t QUEUE_SIZE = 10;
+constexpr size_t RING_SIZE = 1024; // Low latency modes
+
+// Low latency (opt-in) - How the worker waits for events
+enum class WorkerWait {
+    Block,    // BoundedQueue and a condition variable; an idle worker burns no CPU
+    Poll,     // Lock-free ring, spun on without ever sleeping; lowest latency, one core always busy
+    Adaptive, // Lock-free ring, spun on while events keep coming, parked when traffic thins out
+};
+
+struct EventProcessorOptions {
+    bool collectMetrics = false;
+    WorkerWait wait = WorkerWait::Block;
+    int workerCpu = -1; // Pin the worker here (Linux); -1 leaves it to the scheduler
+};
+
+// Low latency (opt-in) - Keeps independently written atomics on separate lines
+constexpr size_t CACHE_LINE = 64;
+
+// Low latency (opt-in) - One step of a polling loop. PAUSE tells the core it
+// is spinning: less power, no memory-order pipeline flush when the loop exits,
+// and the SMT sibling gets the core. With a single CPU nothing we poll for can
+// change until we give the CPU up, so yield instead.
+inline void cpuRelax() {
+    static const bool multiCore = std::thread::hardware_concurrency() > 1;
+    if (!multiCore) {
+        std::this_thread::yield();
+        return;
+    }
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+// Low latency (opt-in) - Exponential backoff capped low: a poller that waits
+// on many pauses adds that many pauses (~40ns each) to the next event's latency
+class SpinBackoff {
+public:
+    void pause() {
+        for (uint32_t i = 0; i < m_pauses; ++i) cpuRelax();
+        m_pauses = std::min(m_pauses * 2, MAX_PAUSES);
+    }
+
+private:
+    static constexpr uint32_t MAX_PAUSES = 16;
+    uint32_t m_pauses = 1;
+};
+
+// Low latency (opt-in) - Pins the calling thread to one CPU. Linux only;
+// elsewhere, or for a CPU we may not run on, returns false and changes nothing.
+inline bool pinCurrentThread(int cpu) {
+#if defined(__linux__)
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(static_cast<size_t>(cpu), &cpus);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+// Low latency (opt-in) - Bounded lock-free multi-producer, single-consumer ring
+// (Vyukov's bounded queue, consumer side simplified for one thread). Each cell
+// carries a sequence number: a producer claims position pos with one CAS on the
+// tail and publishes the cell by storing pos + 1; the consumer frees it by
+// storing pos + Capacity, which is what the producer one lap later waits for.
+// No locks and no syscalls on either side; a full ring makes tryPush fail.
+template <typename T, size_t Capacity>
+class LockFreeRing {
+    static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+
+public:
+    LockFreeRing() {
+        for (size_t i = 0; i < Capacity; ++i) m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // Any thread. Moves from item only when it succeeds.
+    bool tryPush(T& item, Clock::time_point enqueuedAt) {
+        size_t pos = m_tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = m_cells[pos & MASK];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto lag = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (lag == 0) {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.item = std::move(item);
+                    cell.enqueuedAt = enqueuedAt;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false; // Still holds last lap's item: full
+            } else {
+                pos = m_tail.load(std::memory_order_relaxed); // Another producer took it
+            }
+        }
+    }
+
+    // Consumer only
+    bool tryPop(T& item, Clock::time_point& enqueuedAt) {
+        Cell& cell = m_cells[m_head & MASK];
+        if (cell.sequence.load(std::memory_order_acquire) != m_head + 1) return false;
+        item = std::move(cell.item);
+        enqueuedAt = cell.enqueuedAt;
+        cell.sequence.store(m_head + Capacity, std::memory_order_release);
+        ++m_head;
+        return true;
+    }
+
+    // Consumer only: whether tryPop would succeed
+    bool ready() const {
+        return m_cells[m_head & MASK].sequence.load(std::memory_order_acquire) == m_head + 1;
+    }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    // A line per cell, so the consumer reading one cell does not disturb a
+    // producer writing the next
+    struct alignas(CACHE_LINE) Cell {
+        std::atomic<size_t> sequence{0};
+        T item{};
+        Clock::time_point enqueuedAt;
+    };
+
+    alignas(CACHE_LINE) std::atomic<size_t> m_tail{0}; // Producers
+    alignas(CACHE_LINE) size_t m_head = 0;             // Consumer
+    std::array<Cell, Capacity> m_cells;
+};
+
+// Timers - Resolution of EventProcessor timers; one tick of its timing wheel
+using TimerTick = std::chrono::milliseconds;
+
+class EventProcessor;
+
+// Timers - Returned by postAfter/postAt/postEvery. Must not outlive the
+// EventProcessor that issued it.
+class TimerHandle {
+public:
+    TimerHandle() = default;
+
+    // Stops the timer (a periodic one for good). True if it was still pending;
+    // false once a one-shot timer has fired or after an earlier cancel.
+    bool cancel();
+
+private:
+    friend class EventProcessor;
+    TimerHandle(EventProcessor* owner, TimingWheel<Event>::TimerId id) : m_owner(owner), m_id(id) {}
+
+    EventProcessor* m_owner = nullptr;
+    TimingWheel<Event>::TimerId m_id;
+};
+
+// Trace - One posted event as recorded. The payload itself is not kept, only
+// its size, which is what queueing and dispatch costs depend on.
+struct TraceRecord {
+    std::chrono::nanoseconds at{}; // Since recording started
+    uint8_t type = 0;              // Index into Event
+    uint32_t payloadSize = 0;
+    uint32_t producer = 0;         // Numbered per trace, in order of first post
+};
+
+// Trace - Payload size of an event, and an event of a given type and size.
+// A new event type needs a case in each.
+inline uint32_t payloadSizeOf(const Event& e) {
+    return static_cast<uint32_t>(std::visit(overloaded {
+            [](const std::monostate&) -> size_t { return 0; },
+            [](const UserInputEvent& evt) { return evt.input.size(); },
+            [](const NetworkDataEvent& evt) { return evt.data.size(); },
+        }, e));
+}
+
+inline Event makeEvent(uint8_t type, uint32_t payloadSize) {
+    switch (type) {
+    case 1: return UserInputEvent{std::string(payloadSize, 'x')};
+    case 2: return NetworkDataEvent{std::vector<uint8_t>(payloadSize, 0xAB)};
+    default: return std::monostate{};
+    }
+}
+
+// Shared memory - Serialized form of an event: its type index plus the raw
+// payload bytes (payloadSizeOf(e) of them). A new event type needs a case in each.
+inline void copyPayload(const Event& e, uint8_t* out) {
+    std::visit(overloaded {
+            [](const std::monostate&) {},
+            [out](const UserInputEvent& evt) { std::copy(evt.input.begin(), evt.input.end(), out); },
+            [out](const NetworkDataEvent& evt) { std::copy(evt.data.begin(), evt.data.end(), out); },
+        }, e);
+}
+
+inline Event eventFromPayload(uint8_t type, std::span<const uint8_t> payload) {
+    switch (type) {
+    case 1: return UserInputEvent{std::string(payload.begin(), payload.end())};
+    case 2: return NetworkDataEvent{std::vector<uint8_t>(payload.begin(), payload.end())};
+    default: return std::monostate{};
+    }
+}
+
+// Trace - A recorded sequence of posts and its binary file format:
+//   "EVTRACE" + version byte, varint record count, then per record
+//   varint ns since the previous record, type byte, varint payload size,
+//   varint producer.
+// Varints are LEB128 (7 bits per byte, low first), so the file is the same on
+// any platform and a typical record takes 4-6 bytes.
+struct EventTrace {
+    std::vector<TraceRecord> records; // In posting order
+
+    uint32_t producerCount() const {
+        uint32_t count = 0;
+        for (const TraceRecord& r : records) count = std::max(count, r.producer + 1);
+        return count;
+    }
+
+    std::chrono::nanoseconds duration() const {
+        return records.empty() ? std::chrono::nanoseconds{} : records.back().at;
+    }
+
+    // Throws std::runtime_error if the file cannot be written
+    void save(const std::filesystem::path& path) const {
+        std::string bytes(MAGIC);
+        bytes.push_back(static_cast<char>(VERSION));
+        putVarint(bytes, records.size());
+        std::chrono::nanoseconds previous{};
+        for (const TraceRecord& r : records) {
+            putVarint(bytes, static_cast<uint64_t>(std::max(r.at - previous, std::chrono::nanoseconds{}).count()));
+            previous = r.at;
+            bytes.push_back(static_cast<char>(r.type));
+            putVarint(bytes, r.payloadSize);
+            putVarint(bytes, r.producer);
+        }
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!file) throw std::runtime_error("trace: cannot write " + path.string());
+    }
+
+    // Throws std::runtime_error if the file cannot be read or is not a valid trace
+    static EventTrace load(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) throw std::runtime_error("trace: cannot open " + path.string());
+        const std::string bytes{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        const auto fail = [&path](std::string_view why) {
+            return std::runtime_error("trace: " + path.string() + ": " + std::string(why));
+        };
+        if (bytes.size() < MAGIC.size() + 1 || std::string_view(bytes).substr(0, MAGIC.size()) != MAGIC) {
+            throw fail("not a trace file");
+        }
+        if (static_cast<uint8_t>(bytes[MAGIC.size()]) != VERSION) throw fail("unsupported version");
+
+        size_t pos = MAGIC.size() + 1;
+        auto next = [&](uint64_t limit) {
+            uint64_t value = 0;
+            for (unsigned shift = 0;; shift += 7) {
+                if (pos >= bytes.size() || shift > 63) throw fail("truncated or corrupt");
+                const auto byte = static_cast<uint8_t>(bytes[pos++]);
+                value |= uint64_t{byte & 0x7Fu} << shift;
+                if (!(byte & 0x80)) break;
+            }
+            if (value > limit) throw fail("value out of range");
+            return value;
+        };
+        EventTrace trace;
+        const uint64_t count = next(bytes.size()); // Each record takes at least one byte
+        trace.records.reserve(static_cast<size_t>(count));
+        std::chrono::nanoseconds at{};
+        for (uint64_t i = 0; i < count; ++i) {
+            TraceRecord r;
+            at += std::chrono::nanoseconds(static_cast<int64_t>(next(INT64_MAX)));
+            r.at = at;
+            if (pos >= bytes.size()) throw fail("truncated or corrupt");
+            r.type = static_cast<uint8_t>(bytes[pos++]);
+            if (r.type >= std::variant_size_v<Event>) throw fail("unknown event type");
+            r.payloadSize = static_cast<uint32_t>(next(UINT32_MAX));
+            r.producer = static_cast<uint32_t>(next(UINT32_MAX));
+            trace.records.push_back(r);
+        }
+        return trace;
+    }
+
+private:
+    static constexpr std::string_view MAGIC = "EVTRACE";
+    static constexpr uint8_t VERSION = 1;
+
+    static void putVarint(std::string& out, uint64_t value) {
+        for (; value >= 0x80; value >>= 7) out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        out.push_back(static_cast<char>(value));
+    }
+};
+
+// Trace - Attached to an EventProcessor, records every post() from any
+// thread. Costs a clock read and an uncontended lock per post while attached.
+class TraceRecorder {
+public:
+    void record(const Event& e) {
+        const uint32_t size = payloadSizeOf(e);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // Read under the lock so records are in time order
+        const auto at = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_start);
+        const auto [producer, inserted] =
+            m_producers.try_emplace(std::this_thread::get_id(), static_cast<uint32_t>(m_producers.size()));
+        m_trace.records.push_back({at, static_cast<uint8_t>(e.index()), size, producer->second});
+    }
+
+    // Everything recorded so far; recording carries on
+    EventTrace trace() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_trace;
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    const Clock::time_point m_start = Clock::now();
+    std::unordered_map<std::thread::id, uint32_t> m_producers;
+    EventTrace m_trace;
+};
+
+// Metrics (opt-in) - Everything EventProcessor::snapshot() reports
+struct EventProcessorMetrics {
+    QueueMetrics::Snapshot queue;
+    LatencyHistogram::Summary enqueueToDispatch;
+    std::array<LatencyHistogram::Summary, std::variant_size_v<Event>> handlerTime; // Indexed like Event
+    // Histogram counts are sampled events only; pushed/popped are exact
+};
+
+void printMetrics(std::ostream& out, const EventProcessorMetrics& m) {
+    const auto us = [](std::chrono::nanoseconds d) { return static_cast<double>(d.count()) / 1000.0; };
+    const auto line = [&](std::string_view name, const LatencyHistogram::Summary& s) {
+        out << "  " << std::left << std::setw(22) << name << std::right << std::setw(9) << s.count
+            << std::setw(10) << us(s.mean) << std::setw(10) << us(s.p50) << std::setw(10) << us(s.p99)
+            << std::setw(10) << us(s.p999) << std::setw(10) << us(s.max) << "\n";
+    };
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(2);
+    out << "  queue: pushed " << m.queue.pushed << ", popped " << m.queue.popped << ", depth " << m.queue.depth
+        << " (high-water " << m.queue.highWater << ", average " << m.queue.averageDepth << " of " << QUEUE_SIZE
+        << ")\n";
+    out << "  producers blocked " << us(m.queue.producerBlocked) / 1000.0 << " ms, consumer idle "
+        << us(m.queue.consumerIdle) / 1000.0 << " ms\n";
+    out << "  " << std::left << std::setw(22) << "(times in us)" << std::right << std::setw(9) << "sampled"
+        << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10)
+        << "p99.9" << std::setw(10) << "max" << "\n";
+    line("enqueue -> dispatch", m.enqueueToDispatch);
+    for (size_t i = 0; i < m.handlerTime.size(); ++i) {
+        if (m.handlerTime[i].count) line("handler " + std::string(EVENT_TYPE_NAMES[i]), m.handlerTime[i]);
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
 
 // #REQ 3 - Event Processor
 class EventProcessor {
@@ -133,6 +968,34 @@ public:
         std::function<void(const NetworkDataEvent&)>
     >;
 
+    // Metrics (opt-in) - Off by default; when off the only cost is a null check
+    explicit EventProcessor(bool collectMetrics = false)
+        : EventProcessor(EventProcessorOptions{.collectMetrics = collectMetrics}) {}
+
+    // Low latency (opt-in) - In the ring modes the queue counters stay at zero;
+    // the latency histograms are still collected
+    explicit EventProcessor(EventProcessorOptions options)
+        : m_options(options),
+          m_metrics(options.collectMetrics ? std::make_unique<Metrics>() : nullptr),
+          m_ring(options.wait != WorkerWait::Block ? std::make_unique<LockFreeRing<Event, RING_SIZE>>() : nullptr) {
+        if (m_metrics) m_queue.attachMetrics(&m_metrics->queue);
+    }
+
+    // Whether the worker got the CPU asked for in the options
+    bool workerPinned() const { return m_workerPinned.load(); }
+
+    // Safe to call from any thread while events flow; empty without metrics
+    EventProcessorMetrics snapshot() const {
+        EventProcessorMetrics result;
+        if (!m_metrics) return result;
+        result.queue = m_metrics->queue.snapshot();
+        result.enqueueToDispatch = m_metrics->enqueueToDispatch.summary();
+        for (size_t i = 0; i < result.handlerTime.size(); ++i) {
+            result.handlerTime[i] = m_metrics->handlerTime[i].summary();
+        }
+        return result;
+    }
+
     // #REQ 3.a - Register handlers (Type Safe)
     void registerHandler(std::function<void(const UserInputEvent&)> h) {
         m_inputHandler = h;
@@ -142,11 +1005,43 @@ public:
         m_netHandler = h;
     }
 
+    // Trace - Records every post while attached; call before producers start
+    void attachRecorder(TraceRecorder* recorder) { m_recorder = recorder; }
+
+    // Events dispatched so far, timers included; safe from any thread
+    uint64_t dispatchedCount() const { return m_dispatched.load(std::memory_order_relaxed); }
+
     // #REQ 3.b - Post events from producers
     void post(Event e) {
+        if (m_recorder) m_recorder->record(e);
+        if (m_ring) {
+            postToRing(e);
+            return;
+        }
         m_queue.push(std::move(e));
     }
 
+    // Timers - Dispatched by the worker thread, never before the requested
+    // time and normally within a TimerTick after it. They only fire while the
+    // worker runs. One thread per pending timer is what these replace.
+    TimerHandle postAt(Clock::time_point when, Event e) {
+        return schedule(when, Clock::duration::zero(), std::move(e));
+    }
+
+    TimerHandle postAfter(Clock::duration delay, Event e) {
+        return postAt(Clock::now() + delay, std::move(e));
+    }
+
+    // Every period (rounded up to whole ticks) from now, without drift, until cancelled
+    TimerHandle postEvery(Clock::duration period, Event e) {
+        return schedule(Clock::now() + period, period, std::move(e));
+    }
+
+    size_t pendingTimers() const {
+        std::lock_guard<std::mutex> lock(m_timerMutex);
+        return m_timers.size();
+    }
+
     // #REQ 3.c - Worker thread to pop events from the queue and dispatch to handlers
     void start() {
         if (m_worker.joinable()) {
@@ -154,13 +1049,31 @@ public:
         }
 
         auto runWorker = [this](std::stop_token st) {
+            if (m_options.workerCpu >= 0) m_workerPinned.store(pinCurrentThread(m_options.workerCpu));
             while (!st.stop_requested()) {
                 Event e;
-                if (m_queue.pop(e)) {
-                    dispatch(e);
-                } else {
+                Clock::time_point enqueuedAt;
+                // Sleeps no longer than until the next timer is due
+                const Clock::time_point timerDeadline = nextTimerDeadline();
+                const PopResult popped = m_ring ? popRing(e, enqueuedAt, timerDeadline)
+                                                : m_queue.popUntil(e, enqueuedAt, timerDeadline);
+                if (popped == PopResult::Closed) {
                     break; // Queue shut down
                 }
+                if (popped == PopResult::Item) {
+                    if (m_metrics && enqueuedAt != Clock::time_point{}) {
+                        const auto dispatchedAt = Clock::now();
+                        m_metrics->enqueueToDispatch.record(dispatchedAt - enqueuedAt);
+                        dispatch(e);
+                        m_metrics->handlerTime[e.index()].record(Clock::now() - dispatchedAt);
+                    } else {
+                        dispatch(e);
+                    }
+                }
+                // Checked after every event too, so a busy queue cannot starve timers
+                if (timerDeadline != Clock::time_point::max() && Clock::now() >= timerDeadline) {
+                    runDueTimers();
+                }
             }
         };
 
@@ -172,13 +1085,16 @@ public:
     // #REQ 3.d - Manage the lifecycle of thread correctly, ensure a clean shutdown
     void stop() {
         m_queue.shutdown();
+        if (m_ring) {
+            m_ringClosed.store(true);
+            wakeParkedWorker();
+        }
         if (m_worker.joinable()) {
             m_worker.request_stop();
             m_worker.join();
         }
     }
 
-    EventProcessor() = default;
     ~EventProcessor() { stop(); }
     
     // Rule of Five for proper resource management
@@ -188,6 +1104,160 @@ public:
     EventProcessor& operator=(const EventProcessor&) = delete;
 
 private:
+    friend class TimerHandle;
+
+    // Timers - m_workerWakeTick value while the worker has no timer to wait for
+    static constexpr uint64_t NO_WAKE = UINT64_MAX;
+
+    uint64_t tickOf(Clock::duration sinceEpoch, bool roundUp) const {
+        if (sinceEpoch <= Clock::duration::zero()) return 0;
+        return static_cast<uint64_t>(roundUp ? std::chrono::ceil<TimerTick>(sinceEpoch).count()
+                                             : std::chrono::floor<TimerTick>(sinceEpoch).count());
+    }
+
+    TimerHandle schedule(Clock::time_point when, Clock::duration period, Event e) {
+        // Rounded up, so a timer never fires early
+        const uint64_t due = tickOf(when - m_timerEpoch, true);
+        const uint64_t periodTicks = period > Clock::duration::zero() ? std::max<uint64_t>(tickOf(period, true), 1) : 0;
+        TimingWheel<Event>::TimerId id;
+        bool wakeWorker = false;
+        {
+            std::lock_guard<std::mutex> lock(m_timerMutex);
+            id = m_timers.schedule(due, periodTicks, std::move(e));
+            m_timersPending.store(true);
+            // Only a timer due before the worker's planned wake-up needs to wake it
+            wakeWorker = due < m_workerWakeTick;
+        }
+        if (wakeWorker) {
+            if (m_ring) {
+                m_ringInterrupted.store(true);
+                wakeParkedWorker();
+            } else {
+                m_queue.interrupt();
+            }
+        }
+        return TimerHandle(this, id);
+    }
+
+    bool cancelTimer(TimingWheel<Event>::TimerId id) {
+        std::lock_guard<std::mutex> lock(m_timerMutex);
+        return m_timers.cancel(id);
+    }
+
+    // Worker only. Also records the tick it plans to wake at, for schedule().
+    Clock::time_point nextTimerDeadline() {
+        // Cheap common case. While false, m_workerWakeTick is NO_WAKE, so the
+        // next schedule() interrupts the wait that follows.
+        if (!m_timersPending.load()) return Clock::time_point::max();
+        std::lock_guard<std::mutex> lock(m_timerMutex);
+        const std::optional<uint64_t> next = m_timers.nextTick();
+        m_workerWakeTick = next.value_or(NO_WAKE);
+        if (!next) return Clock::time_point::max();
+        return m_timerEpoch + TimerTick(static_cast<TimerTick::rep>(*next));
+    }
+
+    // Worker only. Handlers run after the lock is released, so they may post
+    // events and schedule or cancel timers themselves.
+    void runDueTimers() {
+        {
+            std::lock_guard<std::mutex> lock(m_timerMutex);
+            m_timers.advance(tickOf(Clock::now() - m_timerEpoch, false), [this](Event& e, bool lastTime) {
+                if (lastTime) m_dueEvents.push_back(std::move(e));
+                else m_dueEvents.push_back(e);
+            });
+            if (m_timers.size() == 0) {
+                m_timersPending.store(false);
+                m_workerWakeTick = NO_WAKE;
+            }
+        }
+        for (const Event& e : m_dueEvents) dispatch(e);
+        m_dueEvents.clear();
+    }
+
+    // Low latency (opt-in) - A full ring means the worker is behind; wait for
+    // room the way the worker waits for events. Dropped once stopped, like
+    // BoundedQueue::push after shutdown.
+    void postToRing(Event& e) {
+        const auto postedAt = m_metrics && sampleThisEvent() ? Clock::now() : Clock::time_point{};
+        SpinBackoff backoff;
+        while (!m_ring->tryPush(e, postedAt)) {
+            if (m_ringClosed.load(std::memory_order_relaxed)) return;
+            backoff.pause();
+        }
+        wakeParkedWorker();
+    }
+
+    // Low latency (opt-in) - Worker only. Same contract as BoundedQueue::popUntil.
+    PopResult popRing(Event& e, Clock::time_point& enqueuedAt, Clock::time_point deadline) {
+        if (m_ring->tryPop(e, enqueuedAt)) return PopResult::Item;
+        awaitRing(deadline);
+        // Set only by schedule() after inserting, so the caller's next
+        // nextTimerDeadline() sees the new timer whenever we clear it
+        m_ringInterrupted.store(false, std::memory_order_relaxed);
+        const bool closed = m_ringClosed.load();
+        if (m_ring->tryPop(e, enqueuedAt)) return PopResult::Item;
+        return closed ? PopResult::Closed : PopResult::Timeout;
+    }
+
+    bool ringNeedsWorker() const {
+        return m_ring->ready() || m_ringClosed.load(std::memory_order_relaxed) ||
+               m_ringInterrupted.load(std::memory_order_relaxed);
+    }
+
+    // Low latency (opt-in) - Worker only. Polls until there is something to do
+    // or the deadline passes. In Adaptive mode the polling is bounded by a
+    // budget that doubles each time an event turns up within it and halves
+    // each time it runs out, so steady traffic keeps the worker spinning and
+    // sparse traffic has it park almost at once.
+    void awaitRing(Clock::time_point deadline) {
+        const bool poll = m_options.wait == WorkerWait::Poll;
+        const Clock::time_point spinStart = Clock::now();
+        SpinBackoff backoff;
+        for (uint32_t i = 1;; ++i) {
+            if (ringNeedsWorker()) {
+                if (!poll) m_spinBudget = std::min<Clock::duration>(m_spinBudget * 2, MAX_SPIN);
+                return;
+            }
+            if (i % 8 == 0) { // The clock costs about as much as a pause
+                const Clock::time_point now = Clock::now();
+                if (now >= deadline) return;
+                if (!poll && now - spinStart >= m_spinBudget) break;
+            }
+            backoff.pause();
+        }
+        m_spinBudget = std::max<Clock::duration>(m_spinBudget / 2, MIN_SPIN);
+        park(deadline);
+    }
+
+    // Low latency (opt-in) - Worker only. Sleeps on a condition variable (a
+    // futex on Linux) until wakeParkedWorker() or the deadline.
+    void park(Clock::time_point deadline) {
+        std::unique_lock<std::mutex> lock(m_parkMutex);
+        m_workerParked.store(true, std::memory_order_relaxed);
+        // Pairs with the fence in wakeParkedWorker(): either the producer sees
+        // the flag, or we see what it published before its fence
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!ringNeedsWorker()) {
+            auto woken = [this] { return m_parkWake; };
+            if (deadline == Clock::time_point::max()) m_parkCv.wait(lock, woken);
+            else m_parkCv.wait_until(lock, deadline, woken);
+        }
+        m_parkWake = false;
+        m_workerParked.store(false, std::memory_order_relaxed);
+    }
+
+    // Low latency (opt-in) - Called after publishing an event or a flag. Costs
+    // a fence and a load unless the worker is parked.
+    void wakeParkedWorker() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!m_workerParked.load(std::memory_order_relaxed)) return;
+        {
+            std::lock_guard<std::mutex> lock(m_parkMutex);
+            m_parkWake = true;
+        }
+        m_parkCv.notify_one();
+    }
+
     // Dispatch event to the correct handler based on its type
     void dispatch(const Event& e) {
         std::visit(overloaded {
@@ -205,16 +1275,542 @@ private:
                 },
             }, 
         e);
+        bump(m_dispatched);
     }
 
+    struct Metrics {
+        QueueMetrics queue;
+        LatencyHistogram enqueueToDispatch;
+        std::array<LatencyHistogram, std::variant_size_v<Event>> handlerTime;
+    };
+
+    const EventProcessorOptions m_options;
+
+    // Declared before m_queue, which points into it
+    std::unique_ptr<Metrics> m_metrics;
     BoundedQueue<Event, QUEUE_SIZE> m_queue;
+
+    // Low latency (opt-in) - Used instead of m_queue unless WorkerWait::Block
+    static constexpr std::chrono::microseconds MIN_SPIN{1};
+    static constexpr std::chrono::microseconds MAX_SPIN{100};
+    std::unique_ptr<LockFreeRing<Event, RING_SIZE>> m_ring;
+    std::atomic<bool> m_ringClosed{false};
+    std::atomic<bool> m_ringInterrupted{false}; // A timer is due before the worker planned to look
+    Clock::duration m_spinBudget = MAX_SPIN;    // Worker only
+    alignas(CACHE_LINE) std::atomic<bool> m_workerParked{false};
+    std::mutex m_parkMutex;
+    std::condition_variable m_parkCv;
+    bool m_parkWake = false; // Guarded by m_parkMutex
+    std::atomic<bool> m_workerPinned{false};
+
+    TraceRecorder* m_recorder = nullptr;
+    std::atomic<uint64_t> m_dispatched{0}; // Written by the worker only
+
+    // Timers - Wheel tick 0 is construction time
+    const Clock::time_point m_timerEpoch = Clock::now();
+    mutable std::mutex m_timerMutex; // Guards m_timers and m_workerWakeTick
+    TimingWheel<Event> m_timers;
+    uint64_t m_workerWakeTick = NO_WAKE;
+    std::atomic<bool> m_timersPending{false};
+    std::vector<Event> m_dueEvents; // Worker only; reused between ticks
+
     std::jthread m_worker;
     
     std::function<void(const UserInputEvent&)> m_inputHandler;
     std::function<void(const NetworkDataEvent&)> m_netHandler;
 };
 
-int main() {
+inline bool TimerHandle::cancel() {
+    return m_owner && m_owner->cancelTimer(m_id);
+}
+
+// Trace - How to replay a trace
+struct ReplayOptions {
+    double speed = 1.0;     // 1 keeps the recorded timing, 10 is ten times faster, 0 as fast as possible
+    uint32_t producers = 0; // 0 replays each recorded producer on a thread of its own
+};
+
+struct ReplayReport {
+    uint64_t events = 0;
+    std::chrono::nanoseconds elapsed{}; // From the first post until the last event was dispatched
+    double eventsPerSecond = 0;
+    LatencyHistogram::Summary postLag;  // How late posts left against the schedule (not at speed 0)
+    EventProcessorMetrics processor;    // Latency distributions, if the processor collects metrics
+};
+
+// Trace - Re-posts a trace into a started processor from several producer
+// threads and waits until the processor has dispatched all of it. Recorded
+// producer p is replayed by thread p % producers, in its recorded order.
+// Events are built up front so their allocation is not part of the replay.
+ReplayReport replayTrace(const EventTrace& trace, EventProcessor& processor, ReplayOptions options = {}) {
+    const uint32_t producers =
+        std::max<uint32_t>(options.producers ? options.producers : trace.producerCount(), 1);
+    struct Post {
+        Clock::duration at;
+        Event event;
+    };
+    std::vector<std::vector<Post>> posts(producers);
+    for (const TraceRecord& r : trace.records) {
+        const auto at = options.speed > 0 ? std::chrono::duration_cast<Clock::duration>(
+                                                std::chrono::duration<double, std::nano>(
+                                                    static_cast<double>(r.at.count()) / options.speed))
+                                          : Clock::duration::zero();
+        posts[r.producer % producers].push_back({at, makeEvent(r.type, r.payloadSize)});
+    }
+
+    std::vector<LatencyHistogram> lags(producers); // One writer each, merged at the end
+    const uint64_t target = processor.dispatchedCount() + trace.records.size();
+    const Clock::time_point start = Clock::now();
+    {
+        std::vector<std::jthread> threads;
+        for (uint32_t t = 0; t < producers; ++t) {
+            threads.emplace_back([&, t] {
+                for (Post& post : posts[t]) {
+                    if (options.speed > 0) {
+                        const Clock::time_point due = start + post.at;
+                        // Sleep for the bulk of long gaps, spin out the rest
+                        if (due - Clock::now() > std::chrono::microseconds(200)) {
+                            std::this_thread::sleep_until(due - std::chrono::microseconds(100));
+                        }
+                        while (Clock::now() < due) cpuRelax();
+                        lags[t].record(Clock::now() - due);
+                    }
+                    processor.post(std::move(post.event));
+                }
+            });
+        }
+    }
+    while (processor.dispatchedCount() < target) std::this_thread::yield();
+
+    ReplayReport report;
+    report.events = trace.records.size();
+    report.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+    report.eventsPerSecond = static_cast<double>(report.events) / std::chrono::duration<double>(report.elapsed).count();
+    LatencyHistogram lag;
+    for (const LatencyHistogram& h : lags) lag.merge(h);
+    report.postLag = lag.summary();
+    report.processor = processor.snapshot();
+    return report;
+}
+
+void printReplayReport(std::ostream& out, const ReplayReport& r) {
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(2) << "  " << r.events << " events in "
+        << static_cast<double>(r.elapsed.count()) / 1e6 << " ms: " << r.eventsPerSecond / 1e6 << "M events/s\n";
+    if (r.postLag.count) {
+        out << "  posts behind schedule (us): p50 " << static_cast<double>(r.postLag.p50.count()) / 1000.0 << ", p99 "
+            << static_cast<double>(r.postLag.p99.count()) / 1000.0 << ", max "
+            << static_cast<double>(r.postLag.max.count()) / 1000.0 << "\n";
+    }
+    out.flags(flags);
+    out.precision(precision);
+    printMetrics(out, r.processor);
+}
+
+#if defined(__linux__)
+// Shared memory - Multi-producer, single-consumer ring of serialized events in
+// a POSIX shared memory object, so sidecar processes on the same host can post
+// without sockets. A header, then slotCount fixed-size slots.
+//
+// Producers follow LockFreeRing's protocol, except that a slot's sequence and
+// the pid of the producer writing it share one 64-bit state word:
+//   lap << 32             free for the producer of position lap
+//   lap << 32 | pid       claimed by pid, being written
+//   (lap + 1) << 32       published, waiting for the consumer
+// (positions compared modulo 2^32, plenty for any ring size that fits in memory).
+// Nothing on the fast path makes a syscall: the doorbell, a futex word in the
+// header, is only rung when the consumer has said it is about to sleep.
+//
+// Crashed producers: a slot claimed and never published would stall the
+// consumer for good. Once it has waited STALL_TIMEOUT on one, the consumer
+// checks the claiming pid and takes the slot back if that process is gone
+// (and reaped - a zombie still counts as alive). A slot whose tail position
+// was taken but not yet marked with a pid is taken back after the timeout
+// regardless; should its producer still be alive, its marking CAS fails and
+// it claims another slot, so nothing is lost or torn.
+// A published record whose type or size is out of range (a buggy producer) is
+// dropped rather than read, and counted in recoveredSlots() like a taken-back slot.
+// Only one consumer per ring, and a crashed consumer is not recovered.
+class SharedEventRing {
+    struct Slot;
+
+public:
+    static constexpr uint32_t DEFAULT_SLOTS = 4096;
+    static constexpr uint32_t DEFAULT_SLOT_SIZE = 2048; // Fits a 1500 byte frame
+    static constexpr std::chrono::milliseconds STALL_TIMEOUT{50};
+
+    // Creates the shared memory object, removed again when this is destroyed.
+    // slots must be a power of two and slotSize a multiple of CACHE_LINE.
+    // Throws std::invalid_argument or std::runtime_error (e.g. the name is taken).
+    static SharedEventRing create(const std::string& name, uint32_t slots = DEFAULT_SLOTS,
+                                  uint32_t slotSize = DEFAULT_SLOT_SIZE) {
+        if (!std::has_single_bit(slots) || slotSize % CACHE_LINE != 0 || slotSize <= sizeof(Slot)) {
+            throw std::invalid_argument("shm ring: slots must be a power of two, slot size a multiple of 64");
+        }
+        const size_t bytes = sizeof(Header) + size_t{slots} * slotSize;
+        const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) throw systemError("shm_open " + name);
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            const auto error = systemError("ftruncate " + name);
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            throw error;
+        }
+        void* base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            ::shm_unlink(name.c_str());
+            throw systemError("mmap " + name);
+        }
+
+        SharedEventRing ring(name, base, bytes, true);
+        Header* header = ::new (base) Header{};
+        header->magic = MAGIC;
+        header->version = VERSION;
+        header->slotCount = slots;
+        header->slotSize = slotSize;
+        ring.m_header = header;
+        for (uint32_t i = 0; i < slots; ++i) {
+            ::new (ring.slotAt(i)) Slot{};
+            ring.slotAt(i)->state.store(uint64_t{i} << 32, std::memory_order_relaxed);
+        }
+        header->initialized.store(1, std::memory_order_release);
+        return ring;
+    }
+
+    // Maps a ring created by another process. Throws std::runtime_error.
+    static SharedEventRing open(const std::string& name) {
+        const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) throw systemError("shm_open " + name);
+        struct stat info{};
+        if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+            ::close(fd);
+            throw std::runtime_error("shm ring: " + name + " is not a ring");
+        }
+        const auto bytes = static_cast<size_t>(info.st_size);
+        void* base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) throw systemError("mmap " + name);
+
+        SharedEventRing ring(name, base, bytes, false);
+        ring.m_header = static_cast<Header*>(base);
+        const Header& header = *ring.m_header;
+        if (header.initialized.load(std::memory_order_acquire) != 1 || header.magic != MAGIC ||
+            header.version != VERSION || bytes < sizeof(Header) + size_t{header.slotCount} * header.slotSize) {
+            throw std::runtime_error("shm ring: " + name + " is not a ring, or not initialized yet");
+        }
+        return ring;
+    }
+
+    SharedEventRing(SharedEventRing&& other) noexcept
+        : m_name(std::move(other.m_name)), m_base(std::exchange(other.m_base, nullptr)), m_bytes(other.m_bytes),
+          m_owner(other.m_owner), m_header(other.m_header), m_pid(other.m_pid), m_head(other.m_head),
+          m_stallSince(other.m_stallSince) {}
+    SharedEventRing& operator=(SharedEventRing&&) = delete;
+    SharedEventRing(const SharedEventRing&) = delete;
+    SharedEventRing& operator=(const SharedEventRing&) = delete;
+
+    ~SharedEventRing() {
+        if (!m_base) return;
+        ::munmap(m_base, m_bytes);
+        if (m_owner) ::shm_unlink(m_name.c_str());
+    }
+
+    size_t maxPayload() const { return m_header->slotSize - sizeof(Slot); }
+    uint64_t recoveredSlots() const { return m_header->recovered.load(std::memory_order_relaxed); }
+    uint64_t doorbellRings() const { return m_header->doorbellRings.load(std::memory_order_relaxed); }
+
+    // Producer - A slot being written. commit() publishes it; destroyed
+    // uncommitted, it is published empty and the consumer skips it.
+    class Reservation {
+    public:
+        Reservation(Reservation&& other) noexcept
+            : m_ring(std::exchange(other.m_ring, nullptr)), m_slot(other.m_slot), m_pos(other.m_pos) {}
+        Reservation& operator=(Reservation&&) = delete;
+
+        ~Reservation() {
+            if (!m_ring) return;
+            m_slot->type = 0;
+            m_slot->size = 0;
+            commit();
+        }
+
+        std::span<uint8_t> payload() { return {payloadOf(m_slot), m_slot->size}; }
+
+        void commit() {
+            m_slot->state.store(uint64_t{static_cast<uint32_t>(m_pos + 1)} << 32, std::memory_order_release);
+            std::exchange(m_ring, nullptr)->ringDoorbell();
+        }
+
+    private:
+        friend class SharedEventRing;
+        Reservation(SharedEventRing* ring, Slot* slot, uint64_t pos) : m_ring(ring), m_slot(slot), m_pos(pos) {}
+
+        SharedEventRing* m_ring;
+        Slot* m_slot;
+        uint64_t m_pos;
+    };
+
+    // Producer - Any thread of any process. Empty if the ring is full; throws
+    // std::length_error for a payload over maxPayload().
+    std::optional<Reservation> reserve(uint8_t type, uint32_t size) {
+        if (size > maxPayload()) throw std::length_error("shm ring: payload too large");
+        for (;;) {
+            uint64_t pos = m_header->tail.load(std::memory_order_relaxed);
+            Slot* slot = nullptr;
+            for (;;) {
+                slot = slotAt(pos);
+                const uint64_t state = slot->state.load(std::memory_order_acquire);
+                const auto lag = static_cast<int32_t>(static_cast<uint32_t>(state >> 32) - static_cast<uint32_t>(pos));
+                if (lag == 0) {
+                    if (m_header->tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (lag < 0) {
+                    return std::nullopt; // Still holds last lap's record: full
+                } else {
+                    pos = m_header->tail.load(std::memory_order_relaxed);
+                }
+            }
+            uint64_t unclaimed = uint64_t{static_cast<uint32_t>(pos)} << 32;
+            if (slot->state.compare_exchange_strong(unclaimed, unclaimed | m_pid, std::memory_order_acq_rel)) {
+                slot->type = type;
+                slot->size = size;
+                return Reservation(this, slot, pos);
+            }
+            // The consumer took the slot back while we were descheduled: claim another
+        }
+    }
+
+    // Producer - False if the ring is full
+    bool tryPost(const Event& e) {
+        const uint32_t size = payloadSizeOf(e);
+        std::optional<Reservation> reservation = reserve(static_cast<uint8_t>(e.index()), size);
+        if (!reservation) return false;
+        copyPayload(e, reservation->payload().data());
+        reservation->commit();
+        return true;
+    }
+
+    // Producer - Waits for room like postToRing does
+    void post(const Event& e) {
+        SpinBackoff backoff;
+        while (!tryPost(e)) backoff.pause();
+    }
+
+    // Consumer - One thread of one process
+    bool tryReceive(Event& e) {
+        for (;;) {
+            Slot* slot = slotAt(m_head);
+            const uint64_t state = slot->state.load(std::memory_order_acquire);
+            const auto lap = static_cast<uint32_t>(state >> 32);
+            if (lap == static_cast<uint32_t>(m_head + 1)) {
+                // Any process can write the slot: read its fields once, then check them
+                const uint8_t type = slot->type;
+                const uint32_t size = slot->size;
+                const bool valid = type != 0 && type < std::variant_size_v<Event> && size <= maxPayload();
+                if (valid) {
+                    e = eventFromPayload(type, {payloadOf(slot), size});
+                } else if (type != 0) {
+                    m_header->recovered.fetch_add(1, std::memory_order_relaxed); // Malformed, dropped
+                }
+                freeHeadSlot(slot);
+                if (valid) return true;
+                continue; // Abandoned reservation or malformed record
+            }
+            // Not published. If a producer took the position it is writing, or died.
+            if (lap != static_cast<uint32_t>(m_head) || m_header->tail.load(std::memory_order_acquire) <= m_head) {
+                return false;
+            }
+            if (!recoverStalledHead(slot, state)) return false;
+        }
+    }
+
+    // Consumer - Polls briefly, then sleeps on the doorbell. False on timeout.
+    bool receive(Event& e, Clock::duration timeout) {
+        SpinBackoff backoff;
+        for (int i = 0; i < 64; ++i) {
+            if (tryReceive(e)) return true;
+            backoff.pause();
+        }
+        const Clock::time_point deadline = Clock::now() + timeout;
+        for (;;) {
+            const uint32_t rung = m_header->doorbell.load(std::memory_order_acquire);
+            m_header->consumerSleeping.store(1, std::memory_order_relaxed);
+            // Pairs with the fence in ringDoorbell(), as in EventProcessor::park()
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const bool received = tryReceive(e);
+            const Clock::time_point now = Clock::now();
+            if (received || now >= deadline) {
+                m_header->consumerSleeping.store(0, std::memory_order_relaxed);
+                return received;
+            }
+            // Wakes at least every STALL_TIMEOUT to look for crashed producers
+            const auto nap = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::min<Clock::duration>(deadline - now, STALL_TIMEOUT));
+            const timespec relative{static_cast<time_t>(nap.count() / 1'000'000'000),
+                                    static_cast<long>(nap.count() % 1'000'000'000)};
+            futex(&m_header->doorbell, FUTEX_WAIT, rung, &relative);
+            m_header->consumerSleeping.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    static constexpr uint64_t MAGIC = 0x474E495254564553; // "SEVTRING"
+    static constexpr uint32_t VERSION = 1;
+
+    struct Header {
+        uint64_t magic = 0;
+        uint32_t version = 0;
+        uint32_t slotCount = 0;
+        uint32_t slotSize = 0;
+        std::atomic<uint32_t> initialized{0};
+        alignas(CACHE_LINE) std::atomic<uint64_t> tail{0}; // Producers
+        alignas(CACHE_LINE) std::atomic<uint64_t> head{0}; // Consumer; for inspection only
+        std::atomic<uint64_t> recovered{0};
+        alignas(CACHE_LINE) std::atomic<uint32_t> doorbell{0};
+        std::atomic<uint32_t> consumerSleeping{0};
+        std::atomic<uint64_t> doorbellRings{0};
+    };
+
+    struct Slot {
+        std::atomic<uint64_t> state{0};
+        uint32_t size = 0;
+        uint8_t type = 0;
+        // Payload follows, up to slotSize - sizeof(Slot) bytes
+    };
+
+    // Futexes and these atomics have to work between processes
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free);
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+
+    SharedEventRing(std::string name, void* base, size_t bytes, bool owner)
+        : m_name(std::move(name)), m_base(base), m_bytes(bytes), m_owner(owner),
+          m_pid(static_cast<uint32_t>(::getpid())) {}
+
+    static std::runtime_error systemError(const std::string& what) {
+        return std::runtime_error("shm ring: " + what + ": " + std::strerror(errno));
+    }
+
+    static long futex(std::atomic<uint32_t>* word, int op, uint32_t value, const timespec* timeout) {
+        // Not FUTEX_PRIVATE_FLAG: the waiter and the waker are in different processes
+        return ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), op, value, timeout, nullptr, 0);
+    }
+
+    static uint8_t* payloadOf(Slot* slot) { return reinterpret_cast<uint8_t*>(slot) + sizeof(Slot); }
+
+    Slot* slotAt(uint64_t pos) const {
+        const uint64_t index = pos & (m_header->slotCount - 1);
+        return reinterpret_cast<Slot*>(static_cast<uint8_t*>(m_base) + sizeof(Header) + index * m_header->slotSize);
+    }
+
+    // Producer side, after publishing. One fence and one load unless the
+    // consumer is going to sleep; then one producer (not all) makes the syscall.
+    void ringDoorbell() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!m_header->consumerSleeping.load(std::memory_order_relaxed) ||
+            !m_header->consumerSleeping.exchange(0, std::memory_order_relaxed)) {
+            return;
+        }
+        m_header->doorbell.fetch_add(1, std::memory_order_release);
+        m_header->doorbellRings.fetch_add(1, std::memory_order_relaxed);
+        futex(&m_header->doorbell, FUTEX_WAKE, 1, nullptr);
+    }
+
+    void freeHeadSlot(Slot* slot) {
+        const uint32_t slots = m_header->slotCount;
+        slot->state.store(uint64_t{static_cast<uint32_t>(m_head + slots)} << 32, std::memory_order_release);
+        ++m_head;
+        m_header->head.store(m_head, std::memory_order_relaxed);
+        m_stallSince = {};
+    }
+
+    // The head slot was claimed but is not published. True once it has been
+    // taken back from a dead producer; the clock and kill() only run here.
+    bool recoverStalledHead(Slot* slot, uint64_t state) {
+        const Clock::time_point now = Clock::now();
+        if (m_stallSince == Clock::time_point{}) m_stallSince = now;
+        if (now - m_stallSince < STALL_TIMEOUT) return false;
+        const auto owner = static_cast<pid_t>(static_cast<uint32_t>(state));
+        if (owner != 0 && (::kill(owner, 0) == 0 || errno != ESRCH)) {
+            m_stallSince = now; // Alive, just slow; check again in a while
+            return false;
+        }
+        uint64_t expected = state;
+        const uint64_t reclaimed = uint64_t{static_cast<uint32_t>(m_head + m_header->slotCount)} << 32;
+        if (!slot->state.compare_exchange_strong(expected, reclaimed, std::memory_order_acq_rel)) {
+            return true; // Published or marked after all; look again
+        }
+        ++m_head;
+        m_header->head.store(m_head, std::memory_order_relaxed);
+        m_header->recovered.fetch_add(1, std::memory_order_relaxed);
+        m_stallSince = {};
+        return true;
+    }
+
+    std::string m_name;
+    void* m_base = nullptr;
+    size_t m_bytes = 0;
+    bool m_owner = false;
+    Header* m_header = nullptr;
+    uint32_t m_pid = 0;
+    uint64_t m_head = 0;                 // Consumer only
+    Clock::time_point m_stallSince{};    // Consumer only
+};
+
+// Shared memory - Consumer adaptor. A thread that moves events from a ring
+// into an EventProcessor's post(), so they reach the same dispatch() and
+// handlers as local events, in turn with them and under the same backpressure.
+class SharedEventPump {
+public:
+    SharedEventPump(SharedEventRing& ring, EventProcessor& processor)
+        : m_thread([&ring, &processor, this](std::stop_token st) {
+              while (!st.stop_requested()) {
+                  Event e;
+                  if (ring.receive(e, std::chrono::milliseconds(10))) {
+                      processor.post(std::move(e));
+                      bump(m_pumped);
+                  }
+              }
+          }) {}
+
+    uint64_t pumped() const { return m_pumped.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> m_pumped{0}; // Before m_thread, which uses it
+    std::jthread m_thread;
+};
+
+// Shared memory - The producer process of the demo in main(). Posts count
+// events, mostly small input, every 64th a full network frame. With
+// crash set it then dies halfway through writing one more.
+int runSharedMemoryProducer(const std::string& name, int count, bool crash) {
+    SharedEventRing ring = SharedEventRing::open(name);
+    const NetworkDataEvent frame{std::vector<uint8_t>(1500, 0x42)};
+    for (int i = 0; i < count; ++i) {
+        if (i % 64 == 63) ring.post(frame);
+        else ring.post(UserInputEvent{"tick"});
+    }
+    while (crash) {
+        if (std::optional<SharedEventRing::Reservation> torn = ring.reserve(1, 4)) {
+            std::cout.flush();
+            ::_exit(3); // No destructors: the slot stays claimed by a dead pid
+        }
+        std::this_thread::yield();
+    }
+    return 0;
+}
+#endif
+
+int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv) {
+    using namespace std::chrono_literals;
+#if defined(__linux__)
+    // Shared memory - Producer side of the two-process demo at the end; also
+    // usable by hand against another instance: Task2 --shm-producer /name count
+    if (argc == 4 && (std::string_view(argv[1]) == "--shm-producer" || std::string_view(argv[1]) == "--shm-crash")) {
+        return runSharedMemoryProducer(argv[2], std::stoi(argv[3]), std::string_view(argv[1]) == "--shm-crash");
+    }
+#endif
+
     EventProcessor processor;
 
     // Register Handlers
@@ -237,6 +1833,283 @@ int main() {
 
     producer.join();
     processor.stop(); // Graceful shutdown
-    
+
+    // Metrics (opt-in) - Same load with and without instrumentation. The
+    // budget is 5% of throughput. Runs alternate and the medians are compared,
+    // since a single run varies by more than that.
+    constexpr int LOAD_EVENTS = 100000;
+    constexpr int LOAD_PRODUCERS = 2;
+    auto runLoad = [](bool collectMetrics, EventProcessorMetrics* metrics) {
+        EventProcessor loaded(collectMetrics);
+        std::atomic<int> handled{0};
+        size_t bytes = 0; // Only touched by the worker
+        loaded.registerHandler([&](const UserInputEvent& e) { bytes += e.input.size(); ++handled; });
+        loaded.registerHandler([&](const NetworkDataEvent& e) { bytes += e.data.size(); ++handled; });
+        loaded.start();
+
+        const auto start = Clock::now();
+        {
+            std::vector<std::jthread> producers;
+            for (int t = 0; t < LOAD_PRODUCERS; ++t) {
+                producers.emplace_back([&loaded] {
+                    for (int i = 0; i < LOAD_EVENTS / LOAD_PRODUCERS; ++i) {
+                        if (i % 4) loaded.post(UserInputEvent{"click"});
+                        else loaded.post(NetworkDataEvent{{0xDE, 0xAD, 0xBE, 0xEF}});
+                    }
+                });
+            }
+        }
+        while (handled.load() < LOAD_EVENTS) std::this_thread::yield();
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (metrics) *metrics = loaded.snapshot();
+        loaded.stop();
+        return LOAD_EVENTS / seconds;
+    };
+
+    constexpr int RUNS = 15;
+    std::vector<double> plainRuns, instrumentedRuns;
+    EventProcessorMetrics metrics;
+    for (int run = 0; run < RUNS; ++run) {
+        plainRuns.push_back(runLoad(false, nullptr));
+        instrumentedRuns.push_back(runLoad(true, &metrics));
+    }
+    auto median = [](std::vector<double>& v) {
+        std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(v.size() / 2), v.end());
+        return v[v.size() / 2];
+    };
+    const double plain = median(plainRuns);
+    const double instrumented = median(instrumentedRuns);
+    std::cout << "\n[Metrics] " << LOAD_EVENTS << " events from " << LOAD_PRODUCERS << " producers, queue of "
+              << QUEUE_SIZE << ":\n";
+    printMetrics(std::cout, metrics);
+    std::cout << std::fixed << std::setprecision(1) << "  throughput " << plain / 1e6 << "M/s plain, "
+              << instrumented / 1e6 << "M/s with metrics: overhead " << (1.0 - instrumented / plain) * 100.0
+              << "% (budget 5%)\n";
+
+    // Timers - One-shot, cancelled and periodic, all on the worker thread
+    {
+        EventProcessor timed;
+        std::atomic<int> beats{0};
+        const auto started = Clock::now();
+        timed.registerHandler([started](const UserInputEvent& e) {
+            std::cout << "\n[Timer] " << e.input << " at +"
+                      << std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - started).count() << "ms";
+        });
+        timed.registerHandler([&beats](const NetworkDataEvent&) { ++beats; });
+        timed.start();
+
+        timed.postAfter(30ms, UserInputEvent{"30ms timeout fired"});
+        TimerHandle dropped = timed.postAfter(20ms, UserInputEvent{"cancelled timeout fired (bug)"});
+        TimerHandle heartbeat = timed.postEvery(10ms, NetworkDataEvent{{0x01}});
+        dropped.cancel();
+        std::this_thread::sleep_for(105ms);
+        heartbeat.cancel();
+        std::cout << "\n[Timer] 10ms heartbeat fired " << beats.load() << " times in 105ms\n";
+    }
+
+    // Timers - Many pending at once. Most timeouts are cancelled before they
+    // fire (the reply came), so half are cancelled and the rest fire between
+    // 100ms and 1s out.
+    {
+        constexpr int TIMERS = 200000;
+        constexpr int MIN_DELAY_MS = 100;
+        constexpr int MAX_DELAY_MS = 1000;
+        EventProcessor timed;
+        std::atomic<int> fired{0};
+        timed.registerHandler([&fired](const UserInputEvent&) { ++fired; });
+        timed.start();
+
+        std::vector<TimerHandle> handles;
+        handles.reserve(TIMERS);
+        uint32_t rng = 12345;
+        const auto scheduleStart = Clock::now();
+        for (int i = 0; i < TIMERS; ++i) {
+            rng = rng * 1664525u + 1013904223u;
+            const auto delay = std::chrono::milliseconds(MIN_DELAY_MS + (rng >> 8) % (MAX_DELAY_MS - MIN_DELAY_MS));
+            handles.push_back(timed.postAfter(delay, UserInputEvent{}));
+        }
+        const auto scheduled = Clock::now();
+        const size_t pending = timed.pendingTimers();
+        int cancelled = 0;
+        for (int i = 0; i < TIMERS; i += 2) cancelled += handles[i].cancel() ? 1 : 0;
+        const auto cancelEnd = Clock::now();
+
+        while (fired.load() < TIMERS - cancelled) std::this_thread::sleep_for(1ms);
+        const auto drained = Clock::now();
+        std::this_thread::sleep_for(10ms); // Nothing cancelled may fire late
+
+        const auto nsPer = [](Clock::duration d, int n) {
+            return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()) / n;
+        };
+        std::cout << std::setprecision(0) << "[Timer] " << pending << " pending timeouts: insert "
+                  << nsPer(scheduled - scheduleStart, TIMERS) << "ns, cancel " << nsPer(cancelEnd - scheduled, TIMERS / 2)
+                  << "ns each; " << cancelled << " cancelled, " << fired.load() << " fired, the last "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(drained - scheduled).count()
+                  << "ms after scheduling (latest deadline " << MAX_DELAY_MS << "ms)\n";
+    }
+
+    // Low latency (opt-in) - Post-to-handle latency, one event at a time, the
+    // worker going idle in between: that is where blocking pays for a wake-up.
+    // Events 20us apart (busy) and 500us apart (sparse, where Adaptive parks).
+    {
+        const unsigned cpus = std::max(std::thread::hardware_concurrency(), 1u);
+        const int workerCpu = static_cast<int>(cpus) - 1;
+        auto runPings = [](EventProcessorOptions options, int pings, Clock::duration gap) {
+            EventProcessor pinged(options);
+            LatencyHistogram latency;
+            std::atomic<int> handled{0};
+            // The post time travels in the payload; 8 bytes stay in the string's inline buffer
+            pinged.registerHandler([&](const UserInputEvent& e) {
+                const auto handledAt = Clock::now().time_since_epoch().count();
+                Clock::rep postedAt = 0;
+                std::memcpy(&postedAt, e.input.data(), sizeof(postedAt));
+                latency.record(std::chrono::nanoseconds(handledAt - postedAt));
+                handled.fetch_add(1, std::memory_order_release);
+            });
+            pinged.start();
+            for (int i = 0; i < pings; ++i) {
+                if (gap >= 100us) {
+                    std::this_thread::sleep_for(gap);
+                } else {
+                    for (const auto until = Clock::now() + gap; Clock::now() < until;) cpuRelax();
+                }
+                std::string stamp(sizeof(Clock::rep), '\0');
+                const Clock::rep postedAt = Clock::now().time_since_epoch().count();
+                std::memcpy(stamp.data(), &postedAt, sizeof(postedAt));
+                pinged.post(UserInputEvent{std::move(stamp)});
+                while (handled.load(std::memory_order_acquire) <= i) cpuRelax();
+            }
+            return std::pair{latency.summary(), pinged.workerPinned()};
+        };
+
+        std::cout << "\n[LowLatency] post-to-handle latency, worker pinned to CPU " << workerCpu << " in the ring modes ("
+                  << cpus << " CPU" << (cpus > 1 ? "s" : "") << ")\n";
+        std::cout << "  " << std::left << std::setw(22) << "(times in us)" << std::right << std::setw(9) << "events"
+                  << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10)
+                  << "p99.9" << std::setw(10) << "max" << "\n";
+        const auto us = [](std::chrono::nanoseconds d) { return static_cast<double>(d.count()) / 1000.0; };
+        struct Mode { std::string_view name; WorkerWait wait; };
+        constexpr std::array<Mode, 3> MODES = {{
+            {"block", WorkerWait::Block}, {"poll", WorkerWait::Poll}, {"adaptive", WorkerWait::Adaptive}
+        }};
+        struct Load { std::string_view name; int pings; Clock::duration gap; };
+        const std::array<Load, 2> LOADS = {{{"busy", 20000, 20us}, {"sparse", 2000, 500us}}};
+        std::cout << std::fixed << std::setprecision(2);
+        for (const Load& load : LOADS) {
+            for (const Mode& mode : MODES) {
+                EventProcessorOptions options{.wait = mode.wait};
+                if (mode.wait != WorkerWait::Block) options.workerCpu = workerCpu;
+                const auto [s, pinned] = runPings(options, load.pings, load.gap);
+                const std::string name = std::string(load.name) + " " + std::string(mode.name) +
+                                         (options.workerCpu >= 0 && !pinned ? " (unpinned)" : "");
+                std::cout << "  " << std::left << std::setw(22) << name << std::right << std::setw(9) << s.count
+                          << std::setw(10) << us(s.mean) << std::setw(10) << us(s.p50) << std::setw(10) << us(s.p99)
+                          << std::setw(10) << us(s.p999) << std::setw(10) << us(s.max) << "\n";
+            }
+        }
+        if (cpus == 1) {
+            std::cout << "  With one CPU the poller must yield to let the producer run, so polling cannot win here\n";
+        }
+    }
+
+    // Trace - Record traffic shaped like production (a steady stream of
+    // packets of mixed sizes, bursts of user input) and replay it at recorded
+    // speed, 10x and flat out. A captured trace file can be replayed the same way.
+    {
+        const std::filesystem::path tracePath = std::filesystem::temp_directory_path() / "task2_events.trace";
+        {
+            EventProcessor live;
+            TraceRecorder recorder;
+            live.attachRecorder(&recorder);
+            live.start();
+            std::jthread network([&live] {
+                uint32_t rng = 7;
+                for (int i = 0; i < 4000; ++i) {
+                    rng = rng * 1664525u + 1013904223u;
+                    const size_t size = (rng >> 28) < 12 ? 64 + (rng >> 8) % 256 : 1500; // Mostly small, some full frames
+                    live.post(NetworkDataEvent{std::vector<uint8_t>(size)});
+                    if (i % 16 == 15) std::this_thread::sleep_for(1ms);
+                }
+            });
+            std::jthread input([&live] {
+                for (int burst = 0; burst < 20; ++burst) {
+                    for (int i = 0; i < 50; ++i) live.post(UserInputEvent{"key"});
+                    std::this_thread::sleep_for(10ms);
+                }
+            });
+            network.join();
+            input.join();
+            recorder.trace().save(tracePath);
+        }
+
+        const EventTrace trace = EventTrace::load(tracePath);
+        std::cout << "\n[Trace] " << trace.records.size() << " events from " << trace.producerCount()
+                  << " producers over " << std::chrono::duration_cast<std::chrono::milliseconds>(trace.duration()).count()
+                  << " ms, " << std::filesystem::file_size(tracePath) << " bytes on disk\n";
+        for (double speed : {1.0, 10.0, 0.0}) {
+            EventProcessor replayed(true);
+            replayed.registerHandler([](const UserInputEvent&) {});
+            replayed.registerHandler([](const NetworkDataEvent&) {});
+            replayed.start();
+            std::cout << "[Trace] replay " << (speed > 0 ? std::to_string(static_cast<int>(speed)) + "x" : "flat out")
+                      << ":\n";
+            printReplayReport(std::cout, replayTrace(trace, replayed, {.speed = speed}));
+        }
+        std::filesystem::remove(tracePath);
+    }
+
+#if defined(__linux__)
+    // Shared memory - Two processes: this one consumes, a child started from
+    // the same executable produces. First raw ring throughput, then through
+    // an EventProcessor with a producer that crashes mid-write before another.
+    {
+        const std::string name = "/task2_events_" + std::to_string(::getpid());
+        SharedEventRing ring = SharedEventRing::create(name);
+        auto spawn = [&name](const char* mode, int count) {
+            const std::string countArg = std::to_string(count); // Nothing but exec after fork
+            std::cout.flush();
+            const pid_t child = ::fork();
+            if (child == 0) {
+                ::execl("/proc/self/exe", "Task2", mode, name.c_str(), countArg.c_str(), static_cast<char*>(nullptr));
+                ::_exit(127);
+            }
+            return child;
+        };
+        auto reap = [](pid_t child) {
+            int status = 0;
+            ::waitpid(child, &status, 0);
+            return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+        };
+
+        constexpr int SHM_EVENTS = 2'000'000;
+        const auto start = Clock::now();
+        const pid_t rawProducer = spawn("--shm-producer", SHM_EVENTS);
+        Event e;
+        int received = 0;
+        while (received < SHM_EVENTS && ring.receive(e, 2s)) ++received;
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        const int producerExit = reap(rawProducer);
+        std::cout << "\n[SharedMemory] " << received << " events across processes (producer exit " << producerExit
+                  << ") in " << std::fixed << std::setprecision(1) << seconds * 1000.0 << " ms: " << std::setprecision(2)
+                  << received / seconds / 1e6 << "M events/s, doorbell rang " << ring.doorbellRings()
+                  << " times\n";
+
+        EventProcessor fed;
+        std::atomic<int> inputs{0}, frames{0};
+        fed.registerHandler([&inputs](const UserInputEvent&) { ++inputs; });
+        fed.registerHandler([&frames](const NetworkDataEvent&) { ++frames; });
+        fed.start();
+        SharedEventPump pump(ring, fed);
+        const int crashedExit = reap(spawn("--shm-crash", 1000));   // Posts 1000, then dies mid-write
+        const int healthyExit = reap(spawn("--shm-producer", 100000));
+        const auto giveUpAt = Clock::now() + 5s;
+        while (inputs + frames < 101000 && Clock::now() < giveUpAt) std::this_thread::sleep_for(1ms);
+        std::cout << "[SharedMemory] via EventProcessor: " << inputs << " inputs and " << frames
+                  << " frames handled from a producer that crashed (exit " << crashedExit
+                  << ") and one that did not (exit " << healthyExit << "); " << ring.recoveredSlots()
+                  << " slot recovered from the crashed one\n";
+    }
+#endif
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,370 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// ============================================================================
+// Append-only event log: variant events as tagged records in a chunked arena
+// ============================================================================
+// A std::vector<std::variant<UserInputEvent, NetworkDataEvent>> costs one
+// heap allocation per std::string / std::vector payload. EventLog<Views...>
+// copies each event into the tail of a large chunk instead: an 8-byte header
+// (record size, variant index) followed by the payload inline. Reading yields
+// std::variant<Views...> whose string_view / span members point straight into
+// the chunk, so std::visit works without copying anything.
+//
+// View types are plain aggregates that list their members once:
+//
+//   struct UserInputView {
+//       std::string_view input;
+//       static constexpr auto fields() { return std::tuple{&UserInputView::input}; }
+//   };
+//
+// Supported member types, laid out in the order listed:
+//   trivially copyable T    sizeof(T) bytes, aligned to alignof(T)
+//   std::string_view        u32 length, then the characters
+//   std::span<const T>      u32 count, padding to alignof(T), then the elements
+//
+// Memory is released a whole chunk at a time (consume(), release_until()),
+// and released chunks are kept for reuse, so a steady stream of events stops
+// allocating once the log has warmed up. Views are valid until the chunk that
+// holds them is released. Not thread-safe; guard it like any container.
+
+namespace eventlog {
+
+template <typename V>
+concept RecordView = std::is_aggregate_v<V> && requires { V::fields(); };
+
+namespace detail {
+
+// Variable-length fields and their element type
+template <typename T> struct payload_element {};
+template <> struct payload_element<std::string_view> {
+    using type = char;
+};
+template <typename T> struct payload_element<std::span<const T>> {
+    using type = T;
+};
+
+template <typename M>
+concept PayloadField = requires { typename payload_element<M>::type; };
+
+constexpr std::size_t align_up(std::size_t n, std::size_t a) noexcept {
+    return (n + a - 1) / a * a;
+}
+
+// Walks one field at `offset`; writes it when `base` is non-null
+template <typename M> void put(std::byte* base, std::size_t& offset, const M& value) {
+    if constexpr (PayloadField<M>) {
+        using T = typename payload_element<M>::type;
+        static_assert(std::is_trivially_copyable_v<T> && alignof(T) <= 8);
+        const auto count = static_cast<std::uint32_t>(value.size());
+        offset = align_up(offset, alignof(std::uint32_t));
+        if (base)
+            std::memcpy(base + offset, &count, sizeof count);
+        offset = align_up(offset + sizeof count, alignof(T));
+        if (base && count)
+            std::memcpy(base + offset, value.data(), value.size() * sizeof(T));
+        offset += value.size() * sizeof(T);
+    } else {
+        static_assert(std::is_trivially_copyable_v<M> && alignof(M) <= 8,
+                      "EventLog fields must be trivially copyable, string_view or span<const T>");
+        offset = align_up(offset, alignof(M));
+        if (base)
+            std::memcpy(base + offset, &value, sizeof(M));
+        offset += sizeof(M);
+    }
+}
+
+template <typename M> void get(const std::byte* base, std::size_t& offset, M& value) {
+    if constexpr (PayloadField<M>) {
+        using T = typename payload_element<M>::type;
+        std::uint32_t count = 0;
+        offset = align_up(offset, alignof(std::uint32_t));
+        std::memcpy(&count, base + offset, sizeof count);
+        offset = align_up(offset + sizeof count, alignof(T));
+        value = M(reinterpret_cast<const T*>(base + offset), count);
+        offset += count * sizeof(T);
+    } else {
+        offset = align_up(offset, alignof(M));
+        std::memcpy(&value, base + offset, sizeof(M));
+        offset += sizeof(M);
+    }
+}
+
+struct RecordHeader {
+    std::uint32_t size;  // Whole record including this header; multiple of 8
+    std::uint16_t index; // Variant alternative
+    std::uint16_t reserved;
+};
+static_assert(sizeof(RecordHeader) == 8);
+
+inline constexpr std::size_t record_alignment = 8;
+
+// Walks every field of `view`; returns the padded record size
+template <RecordView V> std::size_t walk_put(std::byte* base, const V& view) {
+    std::size_t offset = sizeof(RecordHeader);
+    std::apply([&](auto... members) { (put(base, offset, view.*members), ...); }, V::fields());
+    return align_up(offset, record_alignment);
+}
+
+template <RecordView V> V walk_get(const std::byte* base) {
+    V view{};
+    std::size_t offset = sizeof(RecordHeader);
+    std::apply([&](auto... members) { (get(base, offset, view.*members), ...); }, V::fields());
+    return view;
+}
+
+struct alignas(16) Chunk {
+    Chunk* next = nullptr;
+    std::size_t used = 0;
+    std::size_t capacity = 0;
+    std::size_t records = 0;
+
+    std::byte* data() noexcept { return reinterpret_cast<std::byte*>(this + 1); }
+
+    static Chunk* allocate(std::size_t capacity) {
+        void* memory = ::operator new(sizeof(Chunk) + capacity);
+        auto* chunk = ::new (memory) Chunk;
+        chunk->capacity = capacity;
+        return chunk;
+    }
+    static void free(Chunk* chunk) noexcept { ::operator delete(chunk); }
+};
+
+} // namespace detail
+
+template <RecordView... Views> class EventLog {
+    static_assert(sizeof...(Views) > 0 && sizeof...(Views) <= 0xFFFF);
+
+public:
+    using value_type = std::variant<Views...>;
+
+    static constexpr std::size_t default_chunk_size = 1024 * 1024;
+
+    // Iterates the records in append order; each dereference decodes a view
+    class iterator {
+    public:
+        using value_type = EventLog::value_type;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+
+        iterator() = default;
+
+        value_type operator*() const {
+            std::byte* record = chunk_->data() + offset_;
+            detail::RecordHeader header;
+            std::memcpy(&header, record, sizeof header);
+            return decoders[header.index](record);
+        }
+
+        iterator& operator++() {
+            detail::RecordHeader header;
+            std::memcpy(&header, chunk_->data() + offset_, sizeof header);
+            offset_ += header.size;
+            skip_exhausted();
+            return *this;
+        }
+        iterator operator++(int) {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const iterator&, const iterator&) = default;
+
+    private:
+        friend class EventLog;
+
+        iterator(detail::Chunk* chunk, std::size_t offset) : chunk_(chunk), offset_(offset) {
+            skip_exhausted();
+        }
+
+        void skip_exhausted() noexcept {
+            while (chunk_ && offset_ == chunk_->used) {
+                chunk_ = chunk_->next;
+                offset_ = 0;
+            }
+        }
+
+        detail::Chunk* chunk_ = nullptr;
+        std::size_t offset_ = 0;
+    };
+
+    explicit EventLog(std::size_t chunk_size = default_chunk_size)
+        : chunk_size_(std::max<std::size_t>(chunk_size, 64)) {}
+
+    EventLog(EventLog&& other) noexcept
+        : chunk_size_(other.chunk_size_), head_(std::exchange(other.head_, nullptr)),
+          tail_(std::exchange(other.tail_, nullptr)), spare_(std::exchange(other.spare_, nullptr)),
+          size_(std::exchange(other.size_, 0)), chunk_allocations_(other.chunk_allocations_) {}
+
+    EventLog& operator=(EventLog&& other) noexcept {
+        if (this != &other) {
+            release_all();
+            free_list(spare_);
+            chunk_size_ = other.chunk_size_;
+            head_ = std::exchange(other.head_, nullptr);
+            tail_ = std::exchange(other.tail_, nullptr);
+            spare_ = std::exchange(other.spare_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            chunk_allocations_ = other.chunk_allocations_;
+        }
+        return *this;
+    }
+
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    ~EventLog() {
+        free_list(head_);
+        free_list(spare_);
+    }
+
+    // Copies the view's payloads into the log
+    template <typename V>
+        requires(std::same_as<V, Views> || ...)
+    void append(const V& view) {
+        const std::size_t bytes = detail::walk_put<V>(nullptr, view);
+        if (bytes > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("EventLog: record too large");
+        std::byte* record = reserve(bytes);
+        std::memset(record, 0, bytes); // Deterministic padding
+        detail::walk_put(record, view);
+        const detail::RecordHeader header{static_cast<std::uint32_t>(bytes),
+                                          static_cast<std::uint16_t>(index_of<V>()), 0};
+        std::memcpy(record, &header, sizeof header);
+        ++tail_->records;
+        ++size_;
+    }
+
+    // Appends whichever alternative `event` holds
+    void append(const value_type& event) {
+        std::visit([this](const auto& view) { append(view); }, event);
+    }
+
+    iterator begin() const noexcept { return iterator(head_, 0); }
+    iterator end() const noexcept { return iterator(); }
+
+    // Visits every record in order, then releases all chunks at once.
+    // Returns the number of records visited.
+    template <typename Visitor> std::size_t consume(Visitor&& visitor) {
+        std::size_t visited = 0;
+        for (iterator it = begin(); it != end(); ++it, ++visited)
+            std::visit(visitor, *it);
+        release_all();
+        return visited;
+    }
+
+    // Releases every chunk that lies entirely before `it`; views into those
+    // chunks dangle afterwards. Records from `it` on stay readable.
+    void release_until(iterator it) noexcept {
+        while (head_ && head_ != it.chunk_) {
+            detail::Chunk* chunk = std::exchange(head_, head_->next);
+            size_ -= chunk->records;
+            recycle(chunk);
+        }
+        if (!head_)
+            tail_ = nullptr;
+    }
+
+    void clear() noexcept { release_all(); }
+
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    std::size_t chunk_size() const noexcept { return chunk_size_; }
+    // Chunks obtained from operator new over the log's lifetime
+    std::size_t chunk_allocations() const noexcept { return chunk_allocations_; }
+
+    // Bytes of records currently held
+    std::size_t bytes_used() const noexcept {
+        std::size_t total = 0;
+        for (const detail::Chunk* c = head_; c; c = c->next)
+            total += c->used;
+        return total;
+    }
+
+private:
+    template <typename V> static constexpr std::size_t index_of() {
+        constexpr std::array matches{std::is_same_v<V, Views>...};
+        return static_cast<std::size_t>(std::find(matches.begin(), matches.end(), true) -
+                                        matches.begin());
+    }
+
+    using decoder = value_type (*)(const std::byte*);
+    static constexpr std::array<decoder, sizeof...(Views)> decoders{
+        +[](const std::byte* record) -> value_type {
+            return value_type(std::in_place_type<Views>, detail::walk_get<Views>(record));
+        }...};
+
+    // Space for `bytes` at the end of the tail chunk, opening a new chunk if
+    // needed; a record larger than a chunk gets a chunk of its own
+    std::byte* reserve(std::size_t bytes) {
+        if (!tail_ || tail_->capacity - tail_->used < bytes) {
+            detail::Chunk* chunk = take_chunk(bytes);
+            if (tail_)
+                tail_->next = chunk;
+            else
+                head_ = chunk;
+            tail_ = chunk;
+        }
+        std::byte* record = tail_->data() + tail_->used;
+        tail_->used += bytes;
+        return record;
+    }
+
+    detail::Chunk* take_chunk(std::size_t bytes) {
+        if (spare_ && spare_->capacity >= bytes) {
+            detail::Chunk* chunk = std::exchange(spare_, spare_->next);
+            chunk->next = nullptr;
+            chunk->used = 0;
+            chunk->records = 0;
+            return chunk;
+        }
+        ++chunk_allocations_;
+        return detail::Chunk::allocate(std::max(chunk_size_, bytes));
+    }
+
+    // Standard-size chunks are kept for reuse; oversized ones are freed
+    void recycle(detail::Chunk* chunk) noexcept {
+        if (chunk->capacity != chunk_size_) {
+            detail::Chunk::free(chunk);
+            return;
+        }
+        chunk->next = spare_;
+        spare_ = chunk;
+    }
+
+    void release_all() noexcept {
+        release_until(end());
+        size_ = 0;
+    }
+
+    static void free_list(detail::Chunk* chunk) noexcept {
+        while (chunk)
+            detail::Chunk::free(std::exchange(chunk, chunk->next));
+    }
+
+    std::size_t chunk_size_;
+    detail::Chunk* head_ = nullptr;
+    detail::Chunk* tail_ = nullptr;
+    detail::Chunk* spare_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t chunk_allocations_ = 0;
+};
+
+} // namespace eventlog
@@ -0,0 +1,495 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+// ============================================================================
+// In-memory images behind std::variant<PngImage, PpmImage, BmpImage>
+// ============================================================================
+// Each alternative owns its pixels (value semantics: copying an Image copies
+// the pixels) and knows how to encode itself. Dispatch is a std::visit, so
+// adding a format means adding one alternative with encode() and extension.
+//
+// Pixels are planar: one 64-byte aligned plane per channel, rows padded to a
+// multiple of 64 bytes. Per-channel loops (thumbnails, conversions) then walk
+// contiguous, aligned memory; encoders interleave while writing.
+//
+// All encoders are self-contained: PPM and BMP are uncompressed by
+// definition, and PNG uses zlib "stored" blocks (no deflate compression), so
+// no external library is needed.
+
+namespace imaging {
+
+// ----------------------------------------------------------------------------
+// Planar pixel storage
+// ----------------------------------------------------------------------------
+
+class PixelBuffer {
+public:
+    static constexpr std::size_t alignment = 64;
+
+    PixelBuffer() = default;
+
+    // 1 = gray, 2 = gray + alpha, 3 = RGB, 4 = RGBA; 8 bits per sample
+    PixelBuffer(std::size_t width, std::size_t height, std::size_t channels)
+        : width_(width), height_(height), channels_(channels),
+          stride_((width + alignment - 1) / alignment * alignment) {
+        if (width == 0 || height == 0 || channels == 0 || channels > 4)
+            throw std::invalid_argument("PixelBuffer: bad dimensions");
+        data_.reset(static_cast<std::uint8_t*>(
+            ::operator new[](bytes(), std::align_val_t{alignment})));
+        std::memset(data_.get(), 0, bytes());
+    }
+
+    PixelBuffer(const PixelBuffer& other)
+        : PixelBuffer(other.empty() ? PixelBuffer{}
+                                    : PixelBuffer(other.width_, other.height_, other.channels_)) {
+        if (!other.empty())
+            std::memcpy(data_.get(), other.data_.get(), bytes());
+    }
+
+    PixelBuffer& operator=(const PixelBuffer& other) {
+        if (this != &other) {
+            PixelBuffer copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    PixelBuffer(PixelBuffer&& other) noexcept = default;
+    PixelBuffer& operator=(PixelBuffer&& other) noexcept = default;
+
+    std::size_t width() const noexcept { return width_; }
+    std::size_t height() const noexcept { return height_; }
+    std::size_t channels() const noexcept { return channels_; }
+    std::size_t stride() const noexcept { return stride_; } // Bytes per plane row
+    bool empty() const noexcept { return data_ == nullptr; }
+
+    // Row y of channel c; width() valid samples, 64-byte aligned
+    std::uint8_t* row(std::size_t c, std::size_t y) noexcept {
+        return data_.get() + (c * height_ + y) * stride_;
+    }
+    const std::uint8_t* row(std::size_t c, std::size_t y) const noexcept {
+        return data_.get() + (c * height_ + y) * stride_;
+    }
+
+    std::uint8_t& at(std::size_t c, std::size_t x, std::size_t y) noexcept { return row(c, y)[x]; }
+    std::uint8_t at(std::size_t c, std::size_t x, std::size_t y) const noexcept { return row(c, y)[x]; }
+
+    // Whole plane including row padding
+    std::span<std::uint8_t> plane(std::size_t c) noexcept {
+        return {row(c, 0), stride_ * height_};
+    }
+    std::span<const std::uint8_t> plane(std::size_t c) const noexcept {
+        return {row(c, 0), stride_ * height_};
+    }
+
+private:
+    struct AlignedDelete {
+        void operator()(std::uint8_t* p) const noexcept {
+            ::operator delete[](p, std::align_val_t{alignment});
+        }
+    };
+
+    std::size_t bytes() const noexcept { return channels_ * height_ * stride_; }
+
+    std::size_t width_ = 0;
+    std::size_t height_ = 0;
+    std::size_t channels_ = 0;
+    std::size_t stride_ = 0;
+    std::unique_ptr<std::uint8_t[], AlignedDelete> data_;
+};
+
+// Box-filtered copy whose longer side is at most max_side pixels
+inline PixelBuffer thumbnail(const PixelBuffer& src, std::size_t max_side) {
+    const std::size_t longest = std::max(src.width(), src.height());
+    if (longest <= max_side)
+        return src;
+    const std::size_t out_w = std::max<std::size_t>(1, src.width() * max_side / longest);
+    const std::size_t out_h = std::max<std::size_t>(1, src.height() * max_side / longest);
+    PixelBuffer out(out_w, out_h, src.channels());
+    for (std::size_t c = 0; c < src.channels(); ++c) {
+        for (std::size_t y = 0; y < out_h; ++y) {
+            const std::size_t y0 = y * src.height() / out_h;
+            const std::size_t y1 = (y + 1) * src.height() / out_h;
+            std::uint8_t* dst = out.row(c, y);
+            for (std::size_t x = 0; x < out_w; ++x) {
+                const std::size_t x0 = x * src.width() / out_w;
+                const std::size_t x1 = (x + 1) * src.width() / out_w;
+                std::size_t sum = 0;
+                for (std::size_t sy = y0; sy < y1; ++sy) {
+                    const std::uint8_t* s = src.row(c, sy);
+                    for (std::size_t sx = x0; sx < x1; ++sx)
+                        sum += s[sx];
+                }
+                const std::size_t n = (y1 - y0) * (x1 - x0);
+                dst[x] = static_cast<std::uint8_t>((sum + n / 2) / n);
+            }
+        }
+    }
+    return out;
+}
+
+// ----------------------------------------------------------------------------
+// Encoders: append the encoded file to `out`
+// ----------------------------------------------------------------------------
+
+namespace detail {
+
+inline void put_u16le(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    out.push_back(static_cast<std::uint8_t>(v));
+    out.push_back(static_cast<std::uint8_t>(v >> 8));
+}
+
+inline void put_u32le(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    put_u16le(out, v & 0xFFFFu);
+    put_u16le(out, v >> 16);
+}
+
+inline void put_u32be(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    for (int shift = 24; shift >= 0; shift -= 8)
+        out.push_back(static_cast<std::uint8_t>(v >> shift));
+}
+
+inline constexpr std::array<std::uint32_t, 256> crc_table = [] {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t n = 0; n < 256; ++n) {
+        std::uint32_t c = n;
+        for (int k = 0; k < 8; ++k)
+            c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        table[n] = c;
+    }
+    return table;
+}();
+
+inline std::uint32_t crc32(std::span<const std::uint8_t> bytes, std::uint32_t crc = 0) {
+    crc = ~crc;
+    for (std::uint8_t b : bytes)
+        crc = crc_table[(crc ^ b) & 0xFFu] ^ (crc >> 8);
+    return ~crc;
+}
+
+// Running Adler-32 as required by the zlib wrapper
+struct Adler32 {
+    std::uint32_t a = 1, b = 0;
+    void update(std::span<const std::uint8_t> bytes) {
+        // 5552 is the largest run that cannot overflow b before the modulo
+        while (!bytes.empty()) {
+            const std::size_t n = std::min<std::size_t>(bytes.size(), 5552);
+            for (std::uint8_t byte : bytes.first(n)) {
+                a += byte;
+                b += a;
+            }
+            a %= 65521u;
+            b %= 65521u;
+            bytes = bytes.subspan(n);
+        }
+    }
+    std::uint32_t value() const noexcept { return (b << 16) | a; }
+};
+
+// Interleaves one row of the given channels into dst (e.g. R,G,B -> RGBRGB)
+inline void interleave_row(const PixelBuffer& img, std::size_t y,
+                           std::span<const std::size_t> channel_order, std::uint8_t* dst) {
+    const std::size_t n = channel_order.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint8_t* src = img.row(channel_order[i], y);
+        for (std::size_t x = 0; x < img.width(); ++x)
+            dst[x * n + i] = src[x];
+    }
+}
+
+} // namespace detail
+
+// Binary PPM/PGM (P6 for colour, P5 for gray); alpha is dropped
+inline void encode_ppm(const PixelBuffer& img, std::vector<std::uint8_t>& out) {
+    const bool color = img.channels() >= 3;
+    const std::array<std::size_t, 3> order = color ? std::array<std::size_t, 3>{0, 1, 2}
+                                                   : std::array<std::size_t, 3>{0, 0, 0};
+    const std::span<const std::size_t> channels(order.data(), color ? 3 : 1);
+    const std::string header = std::string(color ? "P6\n" : "P5\n") + std::to_string(img.width()) +
+                               " " + std::to_string(img.height()) + "\n255\n";
+    const std::size_t row_bytes = img.width() * channels.size();
+    const std::size_t start = out.size();
+    out.resize(start + header.size() + row_bytes * img.height());
+    std::memcpy(out.data() + start, header.data(), header.size());
+    std::uint8_t* dst = out.data() + start + header.size();
+    for (std::size_t y = 0; y < img.height(); ++y, dst += row_bytes)
+        detail::interleave_row(img, y, channels, dst);
+}
+
+// 24-bit uncompressed BMP (bottom-up BGR rows padded to 4 bytes); gray is
+// replicated, alpha is dropped
+inline void encode_bmp(const PixelBuffer& img, std::vector<std::uint8_t>& out) {
+    const std::size_t row_bytes = (img.width() * 3 + 3) / 4 * 4;
+    const std::size_t pixel_bytes = row_bytes * img.height();
+    const auto file_size = static_cast<std::uint32_t>(14 + 40 + pixel_bytes);
+
+    // BITMAPFILEHEADER
+    out.push_back('B');
+    out.push_back('M');
+    detail::put_u32le(out, file_size);
+    detail::put_u32le(out, 0);
+    detail::put_u32le(out, 14 + 40);
+    // BITMAPINFOHEADER
+    detail::put_u32le(out, 40);
+    detail::put_u32le(out, static_cast<std::uint32_t>(img.width()));
+    detail::put_u32le(out, static_cast<std::uint32_t>(img.height()));
+    detail::put_u16le(out, 1);  // Planes
+    detail::put_u16le(out, 24); // Bits per pixel
+    detail::put_u32le(out, 0);  // BI_RGB
+    detail::put_u32le(out, static_cast<std::uint32_t>(pixel_bytes));
+    detail::put_u32le(out, 2835); // 72 dpi
+    detail::put_u32le(out, 2835);
+    detail::put_u32le(out, 0);
+    detail::put_u32le(out, 0);
+
+    const bool color = img.channels() >= 3;
+    const std::array<std::size_t, 3> bgr = color ? std::array<std::size_t, 3>{2, 1, 0}
+                                                 : std::array<std::size_t, 3>{0, 0, 0};
+    const std::size_t start = out.size();
+    out.resize(start + pixel_bytes); // Zero-filled, so the row padding is zero
+    std::uint8_t* dst = out.data() + start;
+    for (std::size_t y = img.height(); y-- > 0; dst += row_bytes)
+        detail::interleave_row(img, y, bgr, dst);
+}
+
+// PNG with an uncompressed ("stored") zlib stream: valid for every decoder,
+// roughly raw size, and far cheaper to produce than deflate
+inline void encode_png_store(const PixelBuffer& img, std::vector<std::uint8_t>& out) {
+    static constexpr std::uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    static constexpr std::uint8_t color_types[] = {0, 0, 4, 2, 6}; // Indexed by channel count
+    static constexpr std::size_t max_block = 65535;
+
+    // Writes length, type, data and CRC; `fill` appends the data
+    auto chunk = [&out](const char (&type)[5], auto fill) {
+        const std::size_t length_at = out.size();
+        detail::put_u32be(out, 0);
+        out.insert(out.end(), type, type + 4);
+        const std::size_t data_at = out.size();
+        fill();
+        const auto length = static_cast<std::uint32_t>(out.size() - data_at);
+        for (int i = 0; i < 4; ++i)
+            out[length_at + static_cast<std::size_t>(i)] =
+                static_cast<std::uint8_t>(length >> (24 - 8 * i));
+        detail::put_u32be(out, detail::crc32(std::span(out).subspan(length_at + 4)));
+    };
+
+    out.insert(out.end(), std::begin(signature), std::end(signature));
+    chunk("IHDR", [&] {
+        detail::put_u32be(out, static_cast<std::uint32_t>(img.width()));
+        detail::put_u32be(out, static_cast<std::uint32_t>(img.height()));
+        out.push_back(8); // Bit depth
+        out.push_back(color_types[img.channels()]);
+        out.push_back(0); // Compression: deflate (stored blocks are deflate)
+        out.push_back(0); // Filter method
+        out.push_back(0); // No interlace
+    });
+
+    chunk("IDAT", [&] {
+        const std::size_t n = img.channels();
+        const std::array<std::size_t, 4> order{0, 1, 2, 3};
+        const std::size_t scanline = 1 + img.width() * n; // Filter byte + samples
+        const std::size_t raw_size = scanline * img.height();
+        const std::size_t blocks = std::max<std::size_t>(1, (raw_size + max_block - 1) / max_block);
+
+        out.push_back(0x78); // zlib: deflate, 32K window
+        out.push_back(0x01); // No preset dictionary, fastest; (0x7801 % 31 == 0)
+        out.reserve(out.size() + raw_size + blocks * 5 + 4);
+
+        // Interleave the scanlines once, then wrap them in stored blocks
+        std::vector<std::uint8_t> raw(raw_size);
+        for (std::size_t y = 0; y < img.height(); ++y) {
+            raw[y * scanline] = 0; // Filter: none
+            detail::interleave_row(img, y, std::span(order).first(n), &raw[y * scanline + 1]);
+        }
+        detail::Adler32 adler;
+        adler.update(raw);
+        for (std::size_t offset = 0; offset < raw_size || offset == 0;) {
+            const std::size_t len = std::min(max_block, raw_size - offset);
+            const bool final = offset + len == raw_size;
+            out.push_back(final ? 1 : 0);
+            detail::put_u16le(out, static_cast<std::uint32_t>(len));
+            detail::put_u16le(out, static_cast<std::uint32_t>(~len & 0xFFFFu));
+            out.insert(out.end(), raw.begin() + static_cast<std::ptrdiff_t>(offset),
+                       raw.begin() + static_cast<std::ptrdiff_t>(offset + len));
+            offset += len;
+            if (final)
+                break;
+        }
+        detail::put_u32be(out, adler.value());
+    });
+    chunk("IEND", [] {});
+}
+
+// ----------------------------------------------------------------------------
+// The variant alternatives
+// ----------------------------------------------------------------------------
+
+struct PngImage {
+    static constexpr std::string_view extension = ".png";
+    PixelBuffer pixels;
+    void encode(std::vector<std::uint8_t>& out) const { encode_png_store(pixels, out); }
+};
+
+struct PpmImage {
+    static constexpr std::string_view extension = ".ppm";
+    PixelBuffer pixels;
+    void encode(std::vector<std::uint8_t>& out) const { encode_ppm(pixels, out); }
+};
+
+struct BmpImage {
+    static constexpr std::string_view extension = ".bmp";
+    PixelBuffer pixels;
+    void encode(std::vector<std::uint8_t>& out) const { encode_bmp(pixels, out); }
+};
+
+using Image = std::variant<PngImage, PpmImage, BmpImage>;
+
+inline const PixelBuffer& pixels(const Image& image) {
+    return std::visit([](const auto& img) -> const PixelBuffer& { return img.pixels; }, image);
+}
+
+inline std::string_view extension(const Image& image) {
+    return std::visit([](const auto& img) { return std::remove_cvref_t<decltype(img)>::extension; }, image);
+}
+
+inline void encode(const Image& image, std::vector<std::uint8_t>& out) {
+    std::visit([&](const auto& img) { img.encode(out); }, image);
+}
+
+// Same format, pixels replaced by a thumbnail
+inline Image with_thumbnail(const Image& image, std::size_t max_side) {
+    return std::visit(
+        [&](const auto& img) -> Image {
+            return std::remove_cvref_t<decltype(img)>{thumbnail(img.pixels, max_side)};
+        },
+        image);
+}
+
+// Writes `bytes` to `path` in one call; throws std::runtime_error on failure
+inline void write_file(const std::filesystem::path& path, std::span<const std::uint8_t> bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(bytes.data()),
+               static_cast<std::streamsize>(bytes.size()));
+    if (!file)
+        throw std::runtime_error("imaging: cannot write " + path.string());
+}
+
+template <typename T>
+concept Encodable = requires(const T& img, std::vector<std::uint8_t>& out) {
+    img.encode(out);
+    { T::extension } -> std::convertible_to<std::string_view>;
+};
+
+// Encodes and writes one image to `stem` + its extension; returns the path
+template <Encodable Img>
+std::filesystem::path save(const Img& image, const std::filesystem::path& stem) {
+    std::vector<std::uint8_t> bytes;
+    image.encode(bytes);
+    std::filesystem::path path = stem;
+    path += Img::extension;
+    write_file(path, bytes);
+    return path;
+}
+
+inline std::filesystem::path save(const Image& image, const std::filesystem::path& stem) {
+    return std::visit([&](const auto& img) { return save(img, stem); }, image);
+}
+
+// ----------------------------------------------------------------------------
+// Batch save: encode on a pool of threads, write with large buffers
+// ----------------------------------------------------------------------------
+
+struct SaveOptions {
+    std::string stem = "image";  // Files are <dir>/<stem>_<index><extension>
+    std::size_t threads = 0;     // 0 = hardware_concurrency()
+    std::size_t max_side = 0;    // > 0: save thumbnails no larger than this
+    std::size_t write_buffer = std::size_t{1} << 20; // Bytes batched per write
+};
+
+struct SaveReport {
+    std::size_t files = 0;
+    std::size_t bytes = 0;
+    std::chrono::nanoseconds elapsed{0};
+};
+
+// Images are independent, so each worker takes the next index, (optionally)
+// thumbnails it, encodes into a buffer it reuses, and writes the file with one
+// large write. The first failure is rethrown after all workers finish.
+inline SaveReport save_all(std::span<const Image> images, const std::filesystem::path& dir,
+                           const SaveOptions& options = {}) {
+    const auto start = std::chrono::steady_clock::now();
+    std::filesystem::create_directories(dir);
+
+    std::size_t threads = options.threads ? options.threads : std::thread::hardware_concurrency();
+    threads = std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(images.size(), 1));
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> total_bytes{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::atomic_flag error_set;
+    {
+        std::vector<std::jthread> workers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                std::vector<std::uint8_t> bytes;
+                bytes.reserve(options.write_buffer);
+                std::vector<char> stream_buffer(options.write_buffer);
+                for (std::size_t i; !failed.load(std::memory_order_relaxed) &&
+                                    (i = next.fetch_add(1)) < images.size();) {
+                    try {
+                        bytes.clear();
+                        if (options.max_side)
+                            encode(with_thumbnail(images[i], options.max_side), bytes);
+                        else
+                            encode(images[i], bytes);
+
+                        std::filesystem::path path =
+                            dir / (options.stem + "_" + std::to_string(i));
+                        path += extension(images[i]);
+                        std::ofstream file;
+                        file.rdbuf()->pubsetbuf(stream_buffer.data(),
+                                                static_cast<std::streamsize>(stream_buffer.size()));
+                        file.open(path, std::ios::binary | std::ios::trunc);
+                        file.write(reinterpret_cast<const char*>(bytes.data()),
+                                   static_cast<std::streamsize>(bytes.size()));
+                        file.close();
+                        if (!file)
+                            throw std::runtime_error("imaging: cannot write " + path.string());
+                        total_bytes.fetch_add(bytes.size(), std::memory_order_relaxed);
+                    } catch (...) {
+                        if (!error_set.test_and_set())
+                            error = std::current_exception();
+                        failed.store(true, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+    }
+    if (error)
+        std::rethrow_exception(error);
+    return {images.size(), total_bytes.load(), std::chrono::steady_clock::now() - start};
+}
+
+} // namespace imaging
@@ -1,12 +1,22 @@
 #include "VariantVisitorSample.hpp"
+#include "EventLog.hpp"
+#include "ImagePipeline.hpp"
 #include <iostream>
 #include <variant>
 #include <vector>
 #include <string>
 #include <functional>
 #include <chrono>
+#include <expected>
+#include <stdexcept>
 #include <type_traits>
 #include <memory>
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <thread>
 
 // Use anonymous namespace to ensure internal linkage and avoid ODR violations
 // with similarly named classes in other translation units
@@ -26,25 +36,33 @@ using ShapeVariant = std::variant<std::monostate, double, int, std::string>;
 // This example demonstrates how std::variant enables dynamic polymorphism
 // with value semantics - no inheritance or heap allocation required!
 
-struct PngImage {
-    void Save(const std::string& file_name) const {
-        std::cout << "Saving " << file_name << ".png\n";
-    }
-    // Some private image data would go here.
-};
-
-struct JpegImage {
-    void Save(const std::string& file_name) const {
-        std::cout << "Saving " << file_name << ".jpg\n";
-    }
-    // Some private image data would go here.
-};
-
-// This alias is only here for convenience.
-using Image = std::variant<PngImage, JpegImage>;
+// The alternatives live in ImagePipeline.hpp: PngImage, PpmImage and BmpImage
+// each own a planar pixel buffer and encode themselves. The variant is still
+// the only thing callers need to know about.
+using imaging::Image;
+using imaging::PngImage;
+using imaging::PpmImage;
+using imaging::BmpImage;
 
 void SaveImage(const Image& image, const std::string& file_name) {
-    std::visit([&](const auto& img) { img.Save(file_name); }, image);
+    std::visit([&](const auto& img) {
+        const auto path = imaging::save(img, file_name);
+        std::cout << "Saving " << path.filename().string() << " ("
+                  << std::filesystem::file_size(path) << " bytes)\n";
+    }, image);
+}
+
+// Test pattern: horizontal red ramp, vertical green ramp, blue checkerboard
+imaging::PixelBuffer make_test_pattern(std::size_t width, std::size_t height, std::size_t seed = 0) {
+    imaging::PixelBuffer pixels(width, height, 3);
+    for (std::size_t y = 0; y < height; ++y) {
+        for (std::size_t x = 0; x < width; ++x) {
+            pixels.at(0, x, y) = static_cast<std::uint8_t>((x * 255 / width + seed) & 0xFF);
+            pixels.at(1, x, y) = static_cast<std::uint8_t>(y * 255 / height);
+            pixels.at(2, x, y) = ((x / 16 + y / 16) % 2) ? 200 : 40;
+        }
+    }
+    return pixels;
 }
 
 // ============================================================================
@@ -149,32 +167,78 @@ public:
 // Example 5: Error Handling and Type Safety
 // ============================================================================
 
+// Validation result for the exception-free path: a code plus the offending
+// number; the text is only built if someone asks for it
+enum class ShapeErrorCode : std::uint8_t { EmptyShape, NonPositiveRadius, TooFewSides, EmptyName };
+
+struct ShapeError {
+    ShapeErrorCode code;
+    double value = 0;
+
+    std::string message() const {
+        switch (code) {
+        case ShapeErrorCode::EmptyShape: return "Cannot process empty shape";
+        case ShapeErrorCode::NonPositiveRadius:
+            return "Radius must be positive (got " + std::to_string(value) + ")";
+        case ShapeErrorCode::TooFewSides:
+            return "Polygon must have at least 3 sides (got " + std::to_string(static_cast<int>(value)) + ")";
+        case ShapeErrorCode::EmptyName: return "Shape name cannot be empty";
+        }
+        return "Unknown shape error";
+    }
+};
+
+// Exception-free visitor: returns std::expected instead of throwing, so it
+// can run inside hot validation loops
+class CheckedShapeVisitor {
+public:
+    std::expected<void, ShapeError> operator()(std::monostate) const noexcept {
+        return std::unexpected(ShapeError{ShapeErrorCode::EmptyShape});
+    }
+    std::expected<void, ShapeError> operator()(double radius) const noexcept {
+        if (radius <= 0) return std::unexpected(ShapeError{ShapeErrorCode::NonPositiveRadius, radius});
+        return {};
+    }
+    std::expected<void, ShapeError> operator()(int sides) const noexcept {
+        if (sides < 3) return std::unexpected(ShapeError{ShapeErrorCode::TooFewSides, static_cast<double>(sides)});
+        return {};
+    }
+    std::expected<void, ShapeError> operator()(const std::string& name) const noexcept {
+        if (name.empty()) return std::unexpected(ShapeError{ShapeErrorCode::EmptyName});
+        return {};
+    }
+};
+
+// Throwing visitor built on the checked one, so both accept the same shapes
 class SafeShapeVisitor {
 public:
     void operator()(std::monostate) const {
-        throw std::runtime_error("Cannot process empty shape");
+        check(std::monostate{});
     }
 
     void operator()(double radius) const {
-        if (radius <= 0) {
-            throw std::invalid_argument("Radius must be positive");
-        }
+        check(radius);
         std::cout << "Valid circle with radius: " << radius << std::endl;
     }
 
     void operator()(int sides) const {
-        if (sides < 3) {
-            throw std::invalid_argument("Polygon must have at least 3 sides");
-        }
+        check(sides);
         std::cout << "Valid polygon with " << sides << " sides" << std::endl;
     }
 
     void operator()(const std::string& name) const {
-        if (name.empty()) {
-            throw std::invalid_argument("Shape name cannot be empty");
-        }
+        check(name);
         std::cout << "Valid named shape: " << name << std::endl;
     }
+
+private:
+    template <typename T> static void check(const T& shape) {
+        if (auto result = CheckedShapeVisitor{}(shape); !result) {
+            if (result.error().code == ShapeErrorCode::EmptyShape)
+                throw std::runtime_error(result.error().message());
+            throw std::invalid_argument(result.error().message());
+        }
+    }
 };
 
 // ============================================================================
@@ -242,18 +306,47 @@ void demonstrateVariantVisitor() {
 
 void demonstrateImageSaving() {
     std::cout << "\n=== Image Saving with Variant (Value Semantics) ===" << std::endl;
-    
-    // Just as before, this can happen at runtime.
-    // We can store different image types in a vector without inheritance!
-    const std::vector<Image> images = {PngImage{}, JpegImage{}};
-    
+
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() /
+        ("variant_images_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    fs::create_directories(dir);
+
+    // Just as before, the format can be chosen at runtime. The vector holds
+    // the images by value - copying an Image copies its pixels.
+    const imaging::PixelBuffer pattern = make_test_pattern(320, 200);
+    const std::vector<Image> images = {PngImage{pattern}, PpmImage{pattern}, BmpImage{pattern}};
+
     for (const auto& image : images) {
-        SaveImage(image, "output");
+        SaveImage(image, (dir / "output").string());
     }
-    
+
+    // Batch job: thumbnails of many images, encoded on a pool of threads
+    constexpr std::size_t batch_size = 1000;
+    std::vector<Image> batch;
+    batch.reserve(batch_size);
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        imaging::PixelBuffer pixels = make_test_pattern(256, 192, i);
+        switch (i % 3) {
+            case 0: batch.emplace_back(PngImage{std::move(pixels)}); break;
+            case 1: batch.emplace_back(PpmImage{std::move(pixels)}); break;
+            default: batch.emplace_back(BmpImage{std::move(pixels)}); break;
+        }
+    }
+
+    const std::size_t threads = std::max(2u, std::thread::hardware_concurrency());
+    for (std::size_t n : {std::size_t{1}, threads}) {
+        const auto report = imaging::save_all(batch, dir / ("thumbs_" + std::to_string(n)),
+                                              {.stem = "thumb", .threads = n, .max_side = 64});
+        std::cout << "save_all: " << report.files << " thumbnails, " << report.bytes / 1024
+                  << " KiB on " << n << " thread(s) in "
+                  << std::chrono::duration<double, std::milli>(report.elapsed).count() << " ms\n";
+    }
+    fs::remove_all(dir);
+
     std::cout << "\nKey insight: We achieved dynamic polymorphism with:" << std::endl;
     std::cout << "- No inheritance hierarchy" << std::endl;
-    std::cout << "- No heap allocation (value semantics)" << std::endl;
+    std::cout << "- No heap allocation for dispatch (value semantics)" << std::endl;
     std::cout << "- No virtual function overhead" << std::endl;
     std::cout << "- Type-safe at compile time" << std::endl;
 }
@@ -534,6 +627,115 @@ void demonstratePerformanceComparison() {
     std::cout << "- Compile-time polymorphism resolution" << std::endl;
 }
 
+// ============================================================================
+// Example 12: Event Log with Arena Allocation
+// ============================================================================
+
+// Owning events, as a typical event queue would hold them: one heap
+// allocation per payload
+struct UserInputEvent { std::string input; };
+struct NetworkDataEvent { std::uint16_t port; std::vector<std::uint8_t> data; };
+using OwningEvent = std::variant<UserInputEvent, NetworkDataEvent>;
+
+// The same events as zero-copy views into an eventlog::EventLog
+struct UserInputView {
+    std::string_view input;
+    static constexpr auto fields() { return std::tuple{&UserInputView::input}; }
+};
+struct NetworkDataView {
+    std::uint16_t port;
+    std::span<const std::uint8_t> data;
+    static constexpr auto fields() {
+        return std::tuple{&NetworkDataView::port, &NetworkDataView::data};
+    }
+};
+using EventLog = eventlog::EventLog<UserInputView, NetworkDataView>;
+
+void demonstrateEventLog() {
+    std::cout << "\n=== Event Log with Arena Allocation ===\n";
+
+    EventLog log(64 * 1024);
+    const std::uint8_t packet[] = {0xDE, 0xAD, 0xBE, 0xEF};
+    log.append(UserInputView{"left click"});
+    log.append(NetworkDataView{8080, packet});
+    log.append(UserInputView{"key: Enter"});
+
+    // Records decode to std::variant<UserInputView, NetworkDataView>
+    const auto printer = overloaded{
+        [](const UserInputView& e) { std::cout << "  input: " << e.input << "\n"; },
+        [](const NetworkDataView& e) {
+            std::cout << "  network: port " << e.port << ", " << e.data.size() << " bytes\n";
+        }
+    };
+    for (const auto& event : log) {
+        std::visit(printer, event);
+    }
+    std::cout << "3 events in " << log.bytes_used() << " bytes, "
+              << log.chunk_allocations() << " chunk allocation(s)\n";
+    log.consume([](const auto&) {});
+
+    // One million small events: owning variants vs the arena log
+    constexpr std::size_t count = 1'000'000;
+    const std::vector<std::uint8_t> payload(24, 0x5A);
+    using ms = std::chrono::duration<double, std::milli>;
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::size_t owning_bytes = 0;
+    {
+        std::vector<OwningEvent> events;
+        events.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (i % 2 == 0)
+                events.emplace_back(UserInputEvent{"user event number " + std::to_string(i)});
+            else
+                events.emplace_back(NetworkDataEvent{static_cast<std::uint16_t>(i), payload});
+        }
+        for (const auto& event : events) {
+            owning_bytes += std::visit(overloaded{
+                [](const UserInputEvent& e) { return e.input.size(); },
+                [](const NetworkDataEvent& e) { return e.data.size(); }
+            }, event);
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    // Two rounds: the second reuses the chunks the first one released
+    EventLog bulk;
+    std::size_t log_bytes = 0;
+    std::size_t first_round_chunks = 0;
+    std::string text;
+    std::chrono::steady_clock::duration first_round{};
+    for (int round = 0; round < 2; ++round) {
+        const auto start = std::chrono::steady_clock::now();
+        log_bytes = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (i % 2 == 0) {
+                text = "user event number " + std::to_string(i);
+                bulk.append(UserInputView{text});
+            } else {
+                bulk.append(NetworkDataView{static_cast<std::uint16_t>(i), payload});
+            }
+        }
+        bulk.consume(overloaded{
+            [&](const UserInputView& e) { log_bytes += e.input.size(); },
+            [&](const NetworkDataView& e) { log_bytes += e.data.size(); }
+        });
+        if (round == 0) {
+            first_round = std::chrono::steady_clock::now() - start;
+            first_round_chunks = bulk.chunk_allocations();
+        }
+    }
+
+    std::cout << count << " events, vector<variant<owning>>: " << ms(t1 - t0).count()
+              << " ms, ~" << count << " payload allocations\n";
+    std::cout << count << " events, EventLog:                " << ms(first_round).count()
+              << " ms, " << first_round_chunks << " chunk allocations of "
+              << bulk.chunk_size() / 1024 << " KiB\n";
+    std::cout << "Second million reused released chunks: "
+              << bulk.chunk_allocations() - first_round_chunks << " new allocations\n";
+    std::cout << "Payload bytes match: " << std::boolalpha << (owning_bytes == log_bytes) << "\n";
+}
+
 } // end anonymous namespace
 
 #include "SampleRegistry.hpp"
@@ -596,6 +798,16 @@ void VariantVisitorSample::run() {
         std::cout << "Unexpected error: " << e.what() << std::endl;
     }
 
+    // Same validation without exceptions
+    std::cout << "\n=== Error Handling with std::expected ===" << std::endl;
+    for (const ShapeVariant& shape : {ShapeVariant{0}, ShapeVariant{-1.5}, ShapeVariant{3.0}, ShapeVariant{}}) {
+        if (auto result = std::visit(CheckedShapeVisitor{}, shape)) {
+            std::cout << "Shape is valid" << std::endl;
+        } else {
+            std::cout << "Rejected: " << result.error().message() << std::endl;
+        }
+    }
+
     // Comparison with inheritance
     // demonstrateInheritanceVariant();  // Disabled due to heap allocation issue
     demonstrateVariantVisitor();
@@ -627,6 +839,9 @@ void VariantVisitorSample::run() {
     // Performance comparison
     demonstratePerformanceComparison();
 
+    // Arena-backed event log
+    demonstrateEventLog();
+
     std::cout << "\n=== Performance Characteristics ===" << std::endl;
     std::cout << "Variant + Visitor Benefits:" << std::endl;
     std::cout << "- No inheritance hierarchy required" << std::endl;
@@ -1,16 +1,92 @@
 #include "ExceptionSafetySample.hpp"
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <expected>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <random>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 // Use anonymous namespace to ensure internal linkage and avoid ODR violations
 namespace {
 
+// ============================================================================
+// Compact Errors for the std::expected APIs
+// ============================================================================
+
+// The throwing operations below each have a try_* twin that returns
+// std::expected<T, Error>. The throwing versions are thin wrappers around the
+// twins, so both report identical failures.
+enum class ErrorCode : std::uint8_t {
+    OperationFailed,
+    ResourceRejected,
+    PositionOutOfRange,
+    InvalidValue,
+};
+
+// A code plus the numbers needed to describe it. It is trivially copyable and
+// fits in registers. The text is only formatted when someone calls message(),
+// and a hot loop that just counts failures never does.
+struct Error {
+    ErrorCode code;
+    std::uint32_t value = 0; // Offending position or input
+    std::uint32_t limit = 0; // Size or bound it was checked against
+
+    // Sizes and positions beyond 32 bits are reported as UINT32_MAX
+    static constexpr std::uint32_t saturate(std::size_t n) noexcept {
+        return n > UINT32_MAX ? UINT32_MAX : static_cast<std::uint32_t>(n);
+    }
+
+    std::string message() const {
+        switch (code) {
+        case ErrorCode::OperationFailed:
+            return "Risky operation failed!";
+        case ErrorCode::ResourceRejected:
+            return "Resource rejected, state rolled back";
+        case ErrorCode::PositionOutOfRange:
+            return "Invalid position " + std::to_string(value) +
+                   " (size " + std::to_string(limit) + ")";
+        case ErrorCode::InvalidValue:
+            return "Invalid value " + std::to_string(value) + " (limit " +
+                   std::to_string(limit) + ")";
+        }
+        return "Unknown error";
+    }
+};
+static_assert(sizeof(Error) <= 12 && std::is_trivially_copyable_v<Error>);
+
+// Throws the same compact Error, for callers that want an exception. what()
+// names the failure kind; error().message() has the numbers.
+class ErrorException : public std::exception {
+public:
+    explicit ErrorException(Error error) noexcept : error_(error) {}
+
+    const Error &error() const noexcept { return error_; }
+
+    const char *what() const noexcept override {
+        switch (error_.code) {
+        case ErrorCode::OperationFailed:
+            return "Operation failed";
+        case ErrorCode::ResourceRejected:
+            return "Resource rejected";
+        case ErrorCode::PositionOutOfRange:
+            return "Position out of range";
+        case ErrorCode::InvalidValue:
+            return "Invalid value";
+        }
+        return "Unknown error";
+    }
+
+private:
+    Error error_;
+};
+
 // ============================================================================
 // Example Classes for Demonstration
 // ============================================================================
@@ -43,10 +119,18 @@ public:
 
     static int getInstanceCount() { return instance_count_; }
 
-    // Simulate an operation that might throw
-    void risky_operation() {
+    // Simulate an operation that might fail
+    std::expected<void, Error> try_risky_operation() const noexcept {
         if (name_ == "RiskySafetyResource") {
-            throw std::runtime_error("Risky operation failed!");
+            return std::unexpected(Error{ErrorCode::OperationFailed});
+        }
+        return {};
+    }
+
+    // Throwing form of try_risky_operation()
+    void risky_operation() {
+        if (auto result = try_risky_operation(); !result) {
+            throw std::runtime_error(result.error().message());
         }
         std::cout << "Risky operation succeeded on '" << name_ << "'"
                   << std::endl;
@@ -83,24 +167,28 @@ public:
     }
 
     // Strong exception safety - operation either succeeds completely or fails
-    // completely
+    // completely. Throwing form of try_add_resource_strong_guarantee()
     void add_resource_strong_guarantee(const std::string &name) {
-        auto temp_resources =
-            resources_; // Copy current state (now possible with shared_ptr)
-        temp_resources.push_back(std::make_shared<SafetyResource>(name));
-
-        // Simulate some work that might fail
-        if (name == "FailStrong") {
-            throw std::runtime_error(
-                "Strong guarantee: operation failed, rolling back");
+        if (auto result = try_add_resource_strong_guarantee(name); !result) {
+            throw std::runtime_error(result.error().message());
         }
-
-        // Only commit if everything succeeds
-        resources_ = std::move(temp_resources);
         std::cout << "Strong guarantee: operation completed successfully"
                   << std::endl;
     }
 
+    // Strong guarantee without exceptions for the expected failure: the
+    // rejected name is reported as a value and resources_ is left untouched.
+    // Validation happens before the only mutation, and push_back itself is
+    // all-or-nothing. (Allocation failure still throws std::bad_alloc.)
+    std::expected<void, Error>
+    try_add_resource_strong_guarantee(const std::string &name) {
+        if (name == "FailStrong") {
+            return std::unexpected(Error{ErrorCode::ResourceRejected});
+        }
+        resources_.push_back(std::make_shared<SafetyResource>(name));
+        return {};
+    }
+
     // No-throw guarantee - operation never throws
     void add_resource_no_throw(const std::string &name) noexcept {
         try {
@@ -214,12 +302,22 @@ public:
         std::cout << "Safely added " << value << " to vector" << std::endl;
     }
 
+    // Insert with strong guarantee; a bad position is returned, not thrown
+    std::expected<void, Error> try_insert(size_t pos, int value) {
+        if (pos > data_.size()) {
+            return std::unexpected(Error{ErrorCode::PositionOutOfRange,
+                                         Error::saturate(pos),
+                                         Error::saturate(data_.size())});
+        }
+        data_.insert(data_.begin() + static_cast<std::ptrdiff_t>(pos), value);
+        return {};
+    }
+
     // Exception-safe insert with strong guarantee
     void insert_safe(size_t pos, int value) {
-        if (pos > data_.size()) {
-            throw std::out_of_range("Invalid position");
+        if (auto result = try_insert(pos, value); !result) {
+            throw std::out_of_range(result.error().message());
         }
-        data_.insert(data_.begin() + pos, value);
         std::cout << "Safely inserted " << value << " at position " << pos
                   << std::endl;
     }
@@ -312,6 +410,23 @@ public:
         levels.list_resources();
     }
 
+    static void test_strong_guarantee_expected() {
+        std::cout << "\n=== Testing Strong Guarantee with std::expected ==="
+                  << std::endl;
+
+        ExceptionSafetyLevels levels;
+        for (const char *name : {"StrongTest", "FailStrong"}) {
+            if (auto result = levels.try_add_resource_strong_guarantee(name);
+                !result) {
+                std::cout << "Rejected '" << name
+                          << "': " << result.error().message() << std::endl;
+            }
+        }
+        std::cout << "Strong guarantee: failed call left "
+                  << levels.size() << " resource(s)" << std::endl;
+        levels.list_resources();
+    }
+
     static void test_no_throw_guarantee() {
         std::cout << "\n=== Testing No-Throw Guarantee ===" << std::endl;
 
@@ -332,6 +447,7 @@ void demonstrate_exception_safety_levels() {
 
     ExceptionSafetyTester::test_basic_guarantee();
     ExceptionSafetyTester::test_strong_guarantee();
+    ExceptionSafetyTester::test_strong_guarantee_expected();
     ExceptionSafetyTester::test_no_throw_guarantee();
 }
 
@@ -405,6 +521,12 @@ void demonstrate_container_exception_safety() {
         std::cout << "Container state remains valid:" << std::endl;
         vec.print();
     }
+
+    // Same failure through the std::expected API: no throw, no catch
+    if (auto result = vec.try_insert(10, 100); !result) {
+        std::cout << "try_insert failed: " << result.error().message()
+                  << std::endl;
+    }
 }
 
 void demonstrate_noexcept_specifications() {
@@ -697,6 +819,81 @@ void demonstrate_std_expected() {
     std::cout << "- Clear intent: success/failure is explicit" << std::endl;
 }
 
+// ============================================================================
+// Throw vs. std::expected Benchmark
+// ============================================================================
+
+constexpr std::uint32_t kMaxReading = 1000;
+
+// A validation stage. Both forms report the same 12-byte Error and neither
+// formats text, so the benchmark measures only the error channel.
+std::expected<std::uint32_t, Error> try_validate(std::uint32_t reading) noexcept {
+    if (reading > kMaxReading) {
+        return std::unexpected(Error{ErrorCode::InvalidValue, reading, kMaxReading});
+    }
+    return reading * 2;
+}
+
+std::uint32_t validate_or_throw(std::uint32_t reading) {
+    if (reading > kMaxReading) {
+        throw ErrorException(Error{ErrorCode::InvalidValue, reading, kMaxReading});
+    }
+    return reading * 2;
+}
+
+void demonstrate_throw_vs_expected() {
+    std::cout << "\n=== Throw vs. std::expected on a Validation Stage ==="
+              << std::endl;
+
+    constexpr std::size_t count = 200'000;
+    using ms = std::chrono::duration<double, std::milli>;
+
+    for (double error_rate : {0.0, 0.01, 0.05, 0.10}) {
+        // Same inputs for both: readings above kMaxReading are invalid
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> coin(0.0, 1.0);
+        std::uniform_int_distribution<std::uint32_t> valid(0, kMaxReading);
+        std::uniform_int_distribution<std::uint32_t> invalid(kMaxReading + 1, 2 * kMaxReading);
+        std::vector<std::uint32_t> inputs(count);
+        for (auto &reading : inputs) {
+            reading = coin(rng) < error_rate ? invalid(rng) : valid(rng);
+        }
+
+        std::uint64_t thrown_sum = 0;
+        std::size_t thrown_errors = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        for (std::uint32_t reading : inputs) {
+            try {
+                thrown_sum += validate_or_throw(reading);
+            } catch (const ErrorException &) {
+                ++thrown_errors;
+            }
+        }
+        auto t1 = std::chrono::steady_clock::now();
+
+        std::uint64_t expected_sum = 0;
+        std::size_t expected_errors = 0;
+        for (std::uint32_t reading : inputs) {
+            if (auto result = try_validate(reading)) {
+                expected_sum += *result;
+            } else {
+                ++expected_errors;
+            }
+        }
+        auto t2 = std::chrono::steady_clock::now();
+
+        std::cout << "error rate " << error_rate * 100 << "%: throw "
+                  << ms(t1 - t0).count() << " ms, expected "
+                  << ms(t2 - t1).count() << " ms (" << thrown_errors
+                  << " errors, results agree: " << std::boolalpha
+                  << (thrown_sum == expected_sum && thrown_errors == expected_errors)
+                  << ")" << std::endl;
+    }
+    std::cout << "Each throw costs microseconds, so the throwing loop slows down "
+                 "as the error rate grows; the std::expected loop stays flat"
+              << std::endl;
+}
+
 // ============================================================================
 // Exceptionless Construction & Factory Pattern Demonstration
 // ============================================================================
@@ -833,6 +1030,7 @@ void ExceptionSafetySample::run() {
     demonstrate_noexcept_specifications();
     demonstrate_exception_handling_best_practices();
     demonstrate_std_expected();
+    demonstrate_throw_vs_expected();
     demonstrate_exceptionless_construction();
 
     std::cout << "\n=== Exception Safety Summary ===" << std::endl;
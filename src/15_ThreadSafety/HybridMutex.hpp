@@ -0,0 +1,308 @@
+#pragma once
+
+#include "SpinWait.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// hybrid_mutex: spin briefly, then sleep in the kernel.
+// profiled_mutex<M>: any mutex plus wait/hold statistics per lock site.
+//
+//   concurrency::profiled_mutex<> mutex_{"BankAccount"};
+//   std::lock_guard lock(mutex_);                  // works like std::mutex
+//   concurrency::contention_report(std::cout);     // which locks hurt?
+//
+// Build with -DLOCK_PROFILING=0 to compile the statistics out; profiled_mutex
+// then costs exactly what the wrapped mutex costs.
+
+#ifndef LOCK_PROFILING
+#define LOCK_PROFILING 1
+#endif
+
+namespace concurrency {
+
+inline constexpr bool lock_profiling = LOCK_PROFILING != 0;
+
+// -----------------------------------------------------------------------------
+// hybrid_mutex
+// -----------------------------------------------------------------------------
+// Three-state futex lock (0 free, 1 locked, 2 locked with sleepers), so an
+// uncontended lock/unlock is one CAS and one exchange with no syscall.
+// std::atomic::wait/notify are futex calls on Linux and WaitOnAddress on
+// Windows. Before sleeping, lock() spins for an adaptive number of rounds:
+// like glibc's PTHREAD_MUTEX_ADAPTIVE_NP, each mutex keeps a running average of
+// how long spinning took to succeed and allows about twice that next time.
+// Short critical sections are therefore handed over without a context switch,
+// and long ones quickly stop burning CPU.
+
+class hybrid_mutex {
+public:
+    hybrid_mutex() = default;
+    hybrid_mutex(const hybrid_mutex&) = delete;
+    hybrid_mutex& operator=(const hybrid_mutex&) = delete;
+
+    void lock() noexcept {
+        std::uint32_t expected = 0;
+        if (!state_.compare_exchange_strong(expected, 1, std::memory_order_acquire,
+                                            std::memory_order_relaxed))
+            lock_slow();
+    }
+
+    bool try_lock() noexcept {
+        std::uint32_t expected = 0;
+        return state_.compare_exchange_strong(expected, 1, std::memory_order_acquire,
+                                              std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept {
+        if (state_.exchange(0, std::memory_order_release) == 2)
+            state_.notify_one();
+    }
+
+private:
+    static constexpr std::uint32_t max_spins = 1000;
+
+    void lock_slow() noexcept {
+        if (spinning_useful()) {
+            const std::uint32_t average = spin_average_.load(std::memory_order_relaxed);
+            const std::uint32_t limit = std::min(max_spins, average * 2 + 10);
+            for (std::uint32_t spins = 0; spins < limit; ++spins) {
+                // Read before the CAS so waiting cores share the line
+                if (state_.load(std::memory_order_relaxed) == 0 && try_lock()) {
+                    adapt(spins);
+                    return;
+                }
+                cpu_relax();
+            }
+            adapt(limit);
+        }
+        // Announce a sleeper; whoever unlocks 2 -> 0 wakes one of us
+        while (state_.exchange(2, std::memory_order_acquire) != 0)
+            state_.wait(2, std::memory_order_relaxed);
+    }
+
+    // average += (spins - average) / 8, kept in integers
+    void adapt(std::uint32_t spins) noexcept {
+        const std::uint32_t average = spin_average_.load(std::memory_order_relaxed);
+        const auto next = static_cast<std::int64_t>(average) +
+                          (static_cast<std::int64_t>(spins) - static_cast<std::int64_t>(average)) / 8;
+        spin_average_.store(static_cast<std::uint32_t>(next), std::memory_order_relaxed);
+    }
+
+    std::atomic<std::uint32_t> state_{0};
+    std::atomic<std::uint32_t> spin_average_{0};
+};
+
+// -----------------------------------------------------------------------------
+// Lock sites and their statistics
+// -----------------------------------------------------------------------------
+
+// Power-of-two buckets of nanoseconds: bucket b counts durations in
+// [2^b, 2^(b+1)). Coarse, but recording is one relaxed increment.
+class duration_histogram {
+public:
+    static constexpr std::size_t buckets = 40; // up to ~18 minutes
+
+    void record(std::chrono::nanoseconds d) noexcept {
+        const auto ns = static_cast<std::uint64_t>(std::max<std::int64_t>(d.count(), 1));
+        const std::size_t bucket = std::min<std::size_t>(std::bit_width(ns) - 1, buckets - 1);
+        counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+        total_ns_.fetch_add(ns, std::memory_order_relaxed);
+        std::uint64_t seen = max_ns_.load(std::memory_order_relaxed);
+        while (ns > seen && !max_ns_.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    std::uint64_t count() const noexcept {
+        std::uint64_t n = 0;
+        for (const auto& c : counts_)
+            n += c.load(std::memory_order_relaxed);
+        return n;
+    }
+
+    std::chrono::nanoseconds total() const noexcept {
+        return std::chrono::nanoseconds(total_ns_.load(std::memory_order_relaxed));
+    }
+
+    std::chrono::nanoseconds max() const noexcept {
+        return std::chrono::nanoseconds(max_ns_.load(std::memory_order_relaxed));
+    }
+
+    // Upper bound of the bucket holding the q-th quantile (capped at the max)
+    std::chrono::nanoseconds percentile(double q) const noexcept {
+        const std::uint64_t n = count();
+        if (n == 0)
+            return {};
+        const auto rank = static_cast<std::uint64_t>(q * static_cast<double>(n - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (std::size_t b = 0; b < buckets; ++b) {
+            seen += counts_[b].load(std::memory_order_relaxed);
+            if (seen >= rank)
+                return std::min(std::chrono::nanoseconds(std::int64_t{2} << b), max());
+        }
+        return max();
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, buckets> counts_{};
+    std::atomic<std::uint64_t> total_ns_{0};
+    std::atomic<std::uint64_t> max_ns_{0};
+};
+
+// Everything known about the mutexes created under one name. Sites live for
+// the whole program so reports can be printed at any time.
+struct lock_site {
+    explicit lock_site(std::string site_name) : name(std::move(site_name)) {}
+
+    const std::string name;
+    std::atomic<std::uint64_t> acquisitions{0};
+    std::atomic<std::uint64_t> contended{0};
+    duration_histogram wait;  // Contended acquisitions only
+    duration_histogram hold;  // One in hold_sample_rate acquisitions
+};
+
+// Hold times cost two clock reads, so only every Nth acquisition is timed
+inline constexpr std::uint64_t hold_sample_rate = 64;
+
+namespace detail {
+
+struct site_registry {
+    std::mutex mutex;
+    std::deque<lock_site> sites; // deque: stable addresses on growth
+
+    static site_registry& instance() {
+        static site_registry registry;
+        return registry;
+    }
+};
+
+} // namespace detail
+
+// Returns the site for `name`, creating it on first use
+inline lock_site& lock_site_for(std::string_view name) {
+    auto& registry = detail::site_registry::instance();
+    std::lock_guard lock(registry.mutex);
+    for (auto& site : registry.sites)
+        if (site.name == name)
+            return site;
+    return registry.sites.emplace_back(std::string(name));
+}
+
+// -----------------------------------------------------------------------------
+// profiled_mutex
+// -----------------------------------------------------------------------------
+// Mutexes constructed with the same name share one site, e.g. every
+// BankAccount. Acquisition first tries try_lock(); only when that fails is the
+// wait timed, so the uncontended path pays two relaxed increments.
+
+template <class Mutex = hybrid_mutex, bool Profile = lock_profiling>
+class profiled_mutex {
+public:
+    explicit profiled_mutex(std::string_view site_name = "unnamed")
+        : site_(Profile ? &lock_site_for(site_name) : nullptr) {}
+
+    profiled_mutex(const profiled_mutex&) = delete;
+    profiled_mutex& operator=(const profiled_mutex&) = delete;
+
+    void lock() {
+        if constexpr (Profile) {
+            if (!mutex_.try_lock()) {
+                const auto start = std::chrono::steady_clock::now();
+                mutex_.lock();
+                site_->wait.record(std::chrono::steady_clock::now() - start);
+                site_->contended.fetch_add(1, std::memory_order_relaxed);
+            }
+            on_acquired();
+        } else {
+            mutex_.lock();
+        }
+    }
+
+    bool try_lock() {
+        if (!mutex_.try_lock())
+            return false;
+        if constexpr (Profile)
+            on_acquired();
+        return true;
+    }
+
+    void unlock() {
+        if constexpr (Profile) {
+            if (held_since_ != std::chrono::steady_clock::time_point{}) {
+                site_->hold.record(std::chrono::steady_clock::now() - held_since_);
+                held_since_ = {};
+            }
+        }
+        mutex_.unlock();
+    }
+
+    // nullptr when profiling is compiled out
+    const lock_site* site() const noexcept { return site_; }
+
+private:
+    // Runs with the lock held, so held_since_ needs no synchronisation
+    void on_acquired() {
+        const std::uint64_t n = site_->acquisitions.fetch_add(1, std::memory_order_relaxed);
+        if (n % hold_sample_rate == 0)
+            held_since_ = std::chrono::steady_clock::now();
+    }
+
+    Mutex mutex_;
+    lock_site* site_;
+    std::chrono::steady_clock::time_point held_since_{};
+};
+
+// -----------------------------------------------------------------------------
+// Report
+// -----------------------------------------------------------------------------
+
+// One line per site, most total wait time first
+inline void contention_report(std::ostream& out) {
+    auto& registry = detail::site_registry::instance();
+    std::vector<const lock_site*> sites;
+    {
+        std::lock_guard lock(registry.mutex);
+        for (const auto& site : registry.sites)
+            sites.push_back(&site);
+    }
+    std::sort(sites.begin(), sites.end(), [](const lock_site* a, const lock_site* b) {
+        return a->wait.total() > b->wait.total();
+    });
+
+    const auto us = [](std::chrono::nanoseconds d) {
+        return std::chrono::duration<double, std::micro>(d).count();
+    };
+
+    out << std::left << std::setw(24) << "site" << std::right << std::setw(11) << "acquired"
+        << std::setw(11) << "contended" << std::setw(13) << "wait total" << std::setw(11)
+        << "wait p50" << std::setw(11) << "wait p99" << std::setw(11) << "wait max"
+        << std::setw(11) << "hold avg" << "  (times in us)\n";
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+    for (const lock_site* site : sites) {
+        const std::uint64_t acquired = site->acquisitions.load(std::memory_order_relaxed);
+        const std::uint64_t contended = site->contended.load(std::memory_order_relaxed);
+        const std::uint64_t holds = site->hold.count();
+        out << std::left << std::setw(24) << site->name << std::right << std::setw(11) << acquired
+            << std::setw(11) << contended << std::setw(13) << us(site->wait.total())
+            << std::setw(11) << us(site->wait.percentile(0.50)) << std::setw(11)
+            << us(site->wait.percentile(0.99)) << std::setw(11) << us(site->wait.max())
+            << std::setw(11)
+            << (holds ? us(site->hold.total()) / static_cast<double>(holds) : 0.0) << '\n';
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+} // namespace concurrency
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "SpinWait.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+// Counters that many threads bump at once.
+//
+//   concurrency::sharded_counter requests;
+//   requests.add();              // relaxed increment of this thread's slot
+//   requests.read();             // O(1), lags by at most shards * batch
+//   requests.sum();              // walks every slot: exact once writers stop
+//
+// A single std::atomic<int> incremented from every core is correct but scales
+// negatively: each fetch_add must own the cache line, so the line travels
+// between cores on every increment. Here every thread (or CPU) increments its
+// own cache-line-sized slot. When a slot's count reaches `batch`, it is folded
+// into a shared total, so the shared line is written once per `batch`
+// increments instead of on every one. This is the scheme of the Linux kernel's
+// percpu_counter.
+
+namespace concurrency {
+
+// Which slot a caller uses
+enum class shard_by {
+    thread, // Stable per-thread index; portable and never migrates
+    cpu,    // sched_getcpu() on Linux (falls back to thread elsewhere)
+};
+
+template <class T> class basic_sharded_counter {
+    static_assert(std::is_integral_v<T>);
+
+public:
+    static constexpr T default_batch = 1024;
+
+    explicit basic_sharded_counter(shard_by policy = shard_by::thread, T batch = default_batch)
+        : shards_(std::bit_ceil(std::max(1u, std::thread::hardware_concurrency()))),
+          slots_(std::make_unique<slot[]>(shards_)), policy_(policy), batch_(batch) {}
+
+    basic_sharded_counter(const basic_sharded_counter&) = delete;
+    basic_sharded_counter& operator=(const basic_sharded_counter&) = delete;
+
+    void add(T n = 1) noexcept {
+        std::atomic<T>& local = slots_[shard()].value;
+        const T now = static_cast<T>(local.fetch_add(n, std::memory_order_relaxed) + n);
+        if (exceeds_batch(now)) {
+            // Whoever takes the slot's value moves it to the total
+            total_.value.fetch_add(local.exchange(0, std::memory_order_relaxed),
+                                   std::memory_order_relaxed);
+        }
+    }
+
+    // Cheap estimate: the folded total only
+    T read() const noexcept { return total_.value.load(std::memory_order_relaxed); }
+
+    // Total plus every slot
+    T sum() const noexcept {
+        T result = total_.value.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < shards_; ++i)
+            result = static_cast<T>(result + slots_[i].value.load(std::memory_order_relaxed));
+        return result;
+    }
+
+    // Not atomic with respect to concurrent add()
+    void reset() noexcept {
+        for (std::size_t i = 0; i < shards_; ++i)
+            slots_[i].value.store(0, std::memory_order_relaxed);
+        total_.value.store(0, std::memory_order_relaxed);
+    }
+
+    std::size_t shards() const noexcept { return shards_; }
+
+private:
+    bool exceeds_batch(T now) const noexcept {
+        if constexpr (std::is_signed_v<T>)
+            return now >= batch_ || now <= -batch_;
+        else
+            return now >= batch_;
+    }
+
+    struct alignas(cache_line_size) slot {
+        std::atomic<T> value{0};
+    };
+
+    std::size_t shard() const noexcept {
+#if defined(__linux__)
+        if (policy_ == shard_by::cpu) {
+            const int cpu = sched_getcpu();
+            if (cpu >= 0)
+                return static_cast<std::size_t>(cpu) & (shards_ - 1);
+        }
+#endif
+        return thread_ordinal() & (shards_ - 1);
+    }
+
+    // 0, 1, 2 ... in order of first use, shared by all counters
+    static std::size_t thread_ordinal() noexcept {
+        static std::atomic<std::size_t> next{0};
+        thread_local const std::size_t ordinal = next.fetch_add(1, std::memory_order_relaxed);
+        return ordinal;
+    }
+
+    std::size_t shards_;
+    std::unique_ptr<slot[]> slots_;
+    slot total_;
+    shard_by policy_;
+    T batch_;
+};
+
+// Monotonic event count (requests served, bytes sent)
+using sharded_counter = basic_sharded_counter<std::uint64_t>;
+
+// Value that goes up and down (connections open, bytes buffered). Slots may be
+// negative; only their sum is meaningful.
+class sharded_gauge : public basic_sharded_counter<std::int64_t> {
+public:
+    using basic_sharded_counter::basic_sharded_counter;
+
+    void sub(std::int64_t n = 1) noexcept { add(-n); }
+};
+
+} // namespace concurrency
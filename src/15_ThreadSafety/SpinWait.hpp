@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+#include <intrin.h>
+#endif
+
+// Small building blocks shared by the lock-free and spinning primitives in
+// this sample.
+
+namespace concurrency {
+
+// Size used to keep independently written atomics on separate cache lines.
+// std::hardware_destructive_interference_size would be the portable spelling,
+// but GCC warns that its value may change between compiler versions, which
+// makes it unsuitable for layouts that end up in headers.
+inline constexpr std::size_t cache_line_size = 64;
+
+// Tells the core we are in a spin loop: on x86 PAUSE lowers power use and
+// avoids the memory-order pipeline flush on exit, and on an SMT core it yields
+// to the sibling hyperthread.
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    __yield();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+// Exponential backoff for spin loops: 1, 2, 4 ... pauses, then yields the
+// time slice once the pause budget is used up.
+class spin_backoff {
+public:
+    void pause() noexcept {
+        if (pauses_ <= max_pauses) {
+            for (unsigned i = 0; i < pauses_; ++i)
+                cpu_relax();
+            pauses_ *= 2;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    void reset() noexcept { pauses_ = 1; }
+
+private:
+    static constexpr unsigned max_pauses = 64;
+    unsigned pauses_ = 1;
+};
+
+// Only spin when another core can release what we are waiting for
+inline bool spinning_useful() noexcept {
+    static const bool multi_core = std::thread::hardware_concurrency() > 1;
+    return multi_core;
+}
+
+} // namespace concurrency
@@ -0,0 +1,251 @@
+#pragma once
+
+#include "SpinWait.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+// Bounded single-producer / single-consumer ring.
+//
+//   concurrency::spsc_queue<Msg> q(1024);
+//   producer:  q.try_push(msg);      q.try_push_n(batch, n);
+//   consumer:  q.try_pop(msg);       q.try_pop_n(out, max);
+//
+// With exactly one thread on each side no lock and no read-modify-write is
+// needed: the producer alone writes tail_, the consumer alone writes head_,
+// and each publishes with a release store that the other side reads with
+// acquire. Every operation is wait-free (a bounded number of steps).
+//
+// Layout matters as much as the algorithm. head_ and tail_ sit on separate
+// cache lines so the two cores do not invalidate each other on every
+// operation. Each side also keeps a private copy of the other side's index
+// and re-reads the shared one only when the copy says full or empty, so in
+// steady state each side mostly touches its own line.
+
+namespace concurrency {
+
+template <class T> class spsc_queue {
+public:
+    // Capacity is rounded up to a power of two
+    explicit spsc_queue(std::size_t capacity)
+        : mask_(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1),
+          slots_(std::make_unique<slot[]>(mask_ + 1)) {}
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    ~spsc_queue() {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        for (std::size_t i = head_.load(std::memory_order_relaxed); i != tail; ++i)
+            slots_[i & mask_].get()->~T();
+    }
+
+    // ---- Producer side ----
+
+    template <class... Args> bool try_emplace(Args&&... args) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ > mask_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ > mask_)
+                return false;
+        }
+        ::new (slots_[tail & mask_].get()) T(std::forward<Args>(args)...);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const T& value) { return try_emplace(value); }
+    bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+    // Copies up to n items from first; returns how many fit. One release
+    // store publishes the whole batch.
+    template <class It> std::size_t try_push_n(It first, std::size_t n) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        std::size_t free = capacity() - (tail - head_cache_);
+        if (free < n) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            free = capacity() - (tail - head_cache_);
+        }
+        const std::size_t count = std::min(n, free);
+        for (std::size_t i = 0; i < count; ++i, ++first)
+            ::new (slots_[(tail + i) & mask_].get()) T(*first);
+        if (count != 0)
+            tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // ---- Consumer side ----
+
+    bool try_pop(T& out) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_)
+                return false;
+        }
+        T* item = slots_[head & mask_].get();
+        out = std::move(*item);
+        item->~T();
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<T> try_pop() {
+        std::optional<T> out;
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_)
+                return out;
+        }
+        T* item = slots_[head & mask_].get();
+        out.emplace(std::move(*item));
+        item->~T();
+        head_.store(head + 1, std::memory_order_release);
+        return out;
+    }
+
+    // Moves up to max items to out; returns how many
+    template <class OutIt> std::size_t try_pop_n(OutIt out, std::size_t max) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        std::size_t available = tail_cache_ - head;
+        if (available < max) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            available = tail_cache_ - head;
+        }
+        const std::size_t count = std::min(max, available);
+        for (std::size_t i = 0; i < count; ++i, ++out) {
+            T* item = slots_[(head + i) & mask_].get();
+            *out = std::move(*item);
+            item->~T();
+        }
+        if (count != 0)
+            head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // ---- Either side (a snapshot; exact only for the calling side) ----
+
+    std::size_t capacity() const noexcept { return mask_ + 1; }
+    std::size_t size() const noexcept {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    bool empty() const noexcept { return size() == 0; }
+
+protected:
+    // Consumer's line: written by the consumer, read by the producer when full
+    alignas(cache_line_size) std::atomic<std::size_t> head_{0};
+    std::size_t tail_cache_ = 0;
+    // Producer's line
+    alignas(cache_line_size) std::atomic<std::size_t> tail_{0};
+    std::size_t head_cache_ = 0;
+
+private:
+    struct slot {
+        alignas(T) std::byte storage[sizeof(T)];
+        T* get() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    // Read-only after construction; may share a line with anything
+    alignas(cache_line_size) const std::size_t mask_;
+    std::unique_ptr<slot[]> slots_;
+};
+
+// spsc_queue plus blocking push/pop. A side that finds the ring full (or
+// empty) spins briefly, then sleeps in std::atomic::wait on the other
+// side's index. The other side notifies only when it sees a sleeper flag,
+// so the try_ operations stay as cheap as in spsc_queue while nobody sleeps.
+template <class T> class blocking_spsc_queue : public spsc_queue<T> {
+    using base = spsc_queue<T>;
+
+public:
+    using base::base;
+
+    template <class U> void push(U&& value) {
+        if (!base::try_push(std::forward<U>(value))) {
+            wait_for(producer_sleeping_, this->head_,
+                     [&] { return base::try_push(std::forward<U>(value)); });
+        }
+        wake(consumer_sleeping_, this->tail_);
+    }
+
+    // Blocks until all n items are in
+    template <class It> void push_n(It first, std::size_t n) {
+        while (n != 0) {
+            std::size_t pushed = base::try_push_n(first, n);
+            if (pushed == 0)
+                wait_for(producer_sleeping_, this->head_,
+                         [&] { return (pushed = base::try_push_n(first, n)) != 0; });
+            std::advance(first, pushed);
+            n -= pushed;
+            wake(consumer_sleeping_, this->tail_);
+        }
+    }
+
+    T pop() {
+        std::optional<T> item = base::try_pop();
+        if (!item)
+            wait_for(consumer_sleeping_, this->tail_,
+                     [&] { return (item = base::try_pop()).has_value(); });
+        wake(producer_sleeping_, this->head_);
+        return std::move(*item);
+    }
+
+    // Blocks until at least one item arrives; returns how many were taken
+    template <class OutIt> std::size_t pop_n(OutIt out, std::size_t max) {
+        std::size_t popped = base::try_pop_n(out, max);
+        if (popped == 0)
+            wait_for(consumer_sleeping_, this->tail_,
+                     [&] { return (popped = base::try_pop_n(out, max)) != 0; });
+        wake(producer_sleeping_, this->head_);
+        return popped;
+    }
+
+private:
+    template <class TryOnce>
+    void wait_for(std::atomic<bool>& sleeping, std::atomic<std::size_t>& index, TryOnce try_once) {
+        if (spinning_useful()) {
+            spin_backoff backoff;
+            for (int i = 0; i < 8; ++i) {
+                if (try_once())
+                    return;
+                backoff.pause();
+            }
+        }
+        for (;;) {
+            const std::size_t seen = index.load(std::memory_order_seq_cst);
+            sleeping.store(true, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (try_once()) {
+                sleeping.store(false, std::memory_order_relaxed);
+                return;
+            }
+            index.wait(seen, std::memory_order_seq_cst);
+            sleeping.store(false, std::memory_order_relaxed);
+            if (try_once())
+                return;
+        }
+    }
+
+    // Called after publishing: the fence orders our index store before the
+    // flag load, pairing with the sleeper's flag store before its last try.
+    // Clearing the flag here means one wake-up per sleep, not one per item.
+    void wake(std::atomic<bool>& sleeping, std::atomic<std::size_t>& index) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_relaxed) &&
+            sleeping.exchange(false, std::memory_order_relaxed))
+            index.notify_one();
+    }
+
+    alignas(cache_line_size) std::atomic<bool> producer_sleeping_{false};
+    alignas(cache_line_size) std::atomic<bool> consumer_sleeping_{false};
+};
+
+} // namespace concurrency
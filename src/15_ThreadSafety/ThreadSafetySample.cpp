@@ -1,4 +1,9 @@
 #include "ThreadSafetySample.hpp"
+#include "HybridMutex.hpp"
+#include "ShardedCounter.hpp"
+#include "SpscQueue.hpp"
+#include "WorkStealingPool.hpp"
+#include <algorithm>
 #include <iostream>
 #include <thread>
 #include <mutex>
@@ -9,6 +14,7 @@
 #include <vector>
 #include <chrono>
 #include <shared_mutex>
+#include <iomanip>
 
 // ============================================================================
 // Helper Classes for Demonstrations
@@ -17,19 +23,20 @@
 class ThreadSafetySample::BankAccount {
 private:
     double balance_ = 0.0;
-    mutable std::mutex mutex_;
+    // Every account reports under one lock site
+    mutable concurrency::profiled_mutex<> mutex_{"BankAccount"};
 
 public:
     BankAccount(double initial_balance = 0.0) : balance_(initial_balance) {}
 
     void deposit(double amount) {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard lock(mutex_);
         balance_ += amount;
         std::cout << "Deposited $" << amount << ", new balance: $" << balance_ << std::endl;
     }
 
     void withdraw(double amount) {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard lock(mutex_);
         if (balance_ >= amount) {
             balance_ -= amount;
             std::cout << "Withdrew $" << amount << ", new balance: $" << balance_ << std::endl;
@@ -39,7 +46,7 @@ public:
     }
 
     double get_balance() const {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard lock(mutex_);
         return balance_;
     }
 
@@ -118,6 +125,7 @@ void ThreadSafetySample::run() {
 
     demonstrate_data_race();
     demonstrate_mutex_solution();
+    demonstrate_hybrid_mutex();
     demonstrate_atomic_solution();
     demonstrate_deadlock_risk();
     demonstrate_scoped_lock_solution();
@@ -126,6 +134,7 @@ void ThreadSafetySample::run() {
     demonstrate_thread_safe_queue();
     demonstrate_reader_writer_lock();
     demonstrate_thread_safety_best_practices();
+    demonstrate_contention_report();
 
     std::cout << "\nThread Safety demonstration completed!" << std::endl;
 }
@@ -173,6 +182,57 @@ void ThreadSafetySample::demonstrate_mutex_solution() {
     std::cout << "Mutex prevents data races!" << std::endl;
 }
 
+void ThreadSafetySample::demonstrate_hybrid_mutex() {
+    std::cout << "\n=== Hybrid Spin-Then-Park Mutex ===" << std::endl;
+    std::cout << "std::mutex already uses a futex, but a contended lock() goes to sleep" << std::endl;
+    std::cout << "at once. For a critical section as short as counter++ the owner is" << std::endl;
+    std::cout << "done long before the sleeper is scheduled again. hybrid_mutex spins" << std::endl;
+    std::cout << "an adaptive number of rounds with PAUSE first, then parks." << std::endl;
+
+    // The critical section from demonstrate_mutex_solution, per thread
+    constexpr int increments = 100000;
+
+    auto run = [](auto& mutex, int threads) {
+        int counter = 0;
+        const auto start = std::chrono::steady_clock::now();
+        {
+            std::vector<std::jthread> workers;
+            for (int t = 0; t < threads; ++t)
+                workers.emplace_back([&] {
+                    for (int i = 0; i < increments; i++) {
+                        std::lock_guard lock(mutex);
+                        counter++;
+                    }
+                });
+        }
+        const std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (counter != threads * increments)
+            std::cout << "  lost updates: " << counter << std::endl;
+        return elapsed.count();
+    };
+
+    std::cout << "\n" << increments << " lock/increment/unlock per thread (ms):" << std::endl;
+    std::cout << std::setw(9) << "threads" << std::setw(13) << "std::mutex" << std::setw(15)
+              << "hybrid_mutex" << std::setw(20) << "profiled<hybrid>" << std::endl;
+    const auto flags = std::cout.flags();
+    const auto precision = std::cout.precision();
+    std::cout << std::fixed << std::setprecision(2);
+    for (int threads : {1, 2, 4, 8}) {
+        std::mutex plain;
+        concurrency::hybrid_mutex hybrid;
+        concurrency::profiled_mutex<> profiled{"counter x" + std::to_string(threads)};
+        std::cout << std::setw(9) << threads << std::setw(13) << run(plain, threads)
+                  << std::setw(15) << run(hybrid, threads) << std::setw(20)
+                  << run(profiled, threads) << std::endl;
+    }
+    std::cout.flags(flags);
+    std::cout.precision(precision);
+    std::cout << "(hardware threads: " << std::thread::hardware_concurrency()
+              << "; with one core nothing can release the lock while we spin," << std::endl;
+    std::cout << " so hybrid_mutex parks straight away)" << std::endl;
+}
+
 void ThreadSafetySample::demonstrate_atomic_solution() {
     std::cout << "\n=== Atomic Solution ===" << std::endl;
 
@@ -196,6 +256,67 @@ void ThreadSafetySample::demonstrate_atomic_solution() {
     // Demonstrate other atomic operations
     std::atomic<bool> flag{false};
     std::cout << "Flag was: " << flag.exchange(true) << ", now: " << flag.load() << std::endl;
+
+    // Every increment above needs the same cache line in exclusive state, so
+    // the line ping-pongs between cores. sharded_counter gives each thread its
+    // own line and folds into a shared total only once per batch.
+    std::cout << "\nShared std::atomic vs sharded_counter, 1M increments per thread (ms):" << std::endl;
+    std::cout << std::setw(9) << "threads" << std::setw(14) << "std::atomic" << std::setw(17)
+              << "sharded_counter" << std::endl;
+
+    constexpr int increments = 1000000;
+    auto time_threads = [](int threads, auto body) {
+        const auto start = std::chrono::steady_clock::now();
+        {
+            std::vector<std::jthread> workers;
+            for (int t = 0; t < threads; ++t)
+                workers.emplace_back(body);
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    };
+
+    const auto flags = std::cout.flags();
+    const auto precision = std::cout.precision();
+    std::cout << std::fixed << std::setprecision(2);
+    const int max_threads = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        std::atomic<std::uint64_t> shared{0};
+        concurrency::sharded_counter sharded;
+        const double shared_ms = time_threads(threads, [&] {
+            for (int i = 0; i < increments; i++)
+                shared.fetch_add(1, std::memory_order_relaxed);
+        });
+        const double sharded_ms = time_threads(threads, [&] {
+            for (int i = 0; i < increments; i++)
+                sharded.add();
+        });
+        std::cout << std::setw(9) << threads << std::setw(14) << shared_ms << std::setw(17)
+                  << sharded_ms;
+        if (sharded.sum() != shared.load())
+            std::cout << "  (sum mismatch!)";
+        std::cout << std::endl;
+    }
+    std::cout.flags(flags);
+    std::cout.precision(precision);
+    std::cout << "(" << std::thread::hardware_concurrency() << " hardware thread(s), "
+              << concurrency::sharded_counter{}.shards() << " shard(s); the shared atomic gets"
+              << " slower per thread as cores are added, the sharded one does not)" << std::endl;
+
+    concurrency::sharded_gauge open_connections;
+    {
+        std::vector<std::jthread> workers;
+        for (int t = 0; t < 4; ++t)
+            workers.emplace_back([&open_connections] {
+                for (int i = 0; i < 10000; i++) {
+                    open_connections.add();  // connection accepted
+                    if (i % 4 != 0)
+                        open_connections.sub();  // ... and 3 in 4 closed again
+                }
+            });
+    }
+    std::cout << "Gauge after 40000 opens / 30000 closes: read() ~ " << open_connections.read()
+              << ", sum() = " << open_connections.sum() << std::endl;
 }
 
 void ThreadSafetySample::demonstrate_deadlock_risk() {
@@ -290,6 +411,78 @@ void ThreadSafetySample::demonstrate_condition_variables() {
     cons.join();
 
     std::cout << "Producer-consumer pattern completed!" << std::endl;
+
+    // With exactly one producer and one consumer the mutex is not needed at
+    // all: spsc_queue hands items over with one release store per side.
+    std::cout << "\nOne producer, one consumer, same traffic without the sleeps:" << std::endl;
+    using seconds = std::chrono::duration<double>;
+    const auto rate = [](std::size_t n, seconds s) { return static_cast<double>(n) / s.count() / 1e6; };
+
+    constexpr int string_messages = 200000;
+    auto start = std::chrono::steady_clock::now();
+    {
+        ThreadSafeQueue locked;
+        std::jthread prod_thread([&] {
+            for (int i = 0; i < string_messages; i++)
+                locked.push("Message " + std::to_string(i));
+            locked.push("DONE");
+        });
+        while (locked.pop() != "DONE") {
+        }
+    }
+    const seconds locked_time = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    {
+        concurrency::blocking_spsc_queue<std::string> ring(1024);
+        std::jthread prod_thread([&] {
+            for (int i = 0; i < string_messages; i++)
+                ring.push("Message " + std::to_string(i));
+            ring.push(std::string("DONE"));
+        });
+        while (ring.pop() != "DONE") {
+        }
+    }
+    const seconds ring_time = std::chrono::steady_clock::now() - start;
+
+    // Plain integers in batches of 256: one index store per batch
+    constexpr std::uint64_t batch_messages = 20000000;
+    start = std::chrono::steady_clock::now();
+    std::uint64_t checksum = 0;
+    {
+        concurrency::blocking_spsc_queue<std::uint64_t> ring(4096);
+        std::jthread prod_thread([&] {
+            std::uint64_t batch[256];
+            for (std::uint64_t next = 0; next < batch_messages;) {
+                std::size_t n = 0;
+                while (n < 256 && next < batch_messages)
+                    batch[n++] = next++;
+                ring.push_n(batch, n);
+            }
+        });
+        std::uint64_t batch[256];
+        for (std::uint64_t received = 0; received < batch_messages;) {
+            const std::size_t n = ring.pop_n(batch, 256);
+            for (std::size_t i = 0; i < n; i++)
+                checksum += batch[i];
+            received += n;
+        }
+    }
+    const seconds batch_time = std::chrono::steady_clock::now() - start;
+
+    const auto flags = std::cout.flags();
+    const auto precision = std::cout.precision();
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "  ThreadSafeQueue (mutex + condvar), strings: "
+              << rate(string_messages, locked_time) << " M msg/s" << std::endl;
+    std::cout << "  blocking_spsc_queue, strings:                "
+              << rate(string_messages, ring_time) << " M msg/s" << std::endl;
+    std::cout << "  blocking_spsc_queue, uint64 x256 batches:    "
+              << rate(batch_messages, batch_time) << " M msg/s"
+              << (checksum == batch_messages * (batch_messages - 1) / 2 ? "" : " (checksum mismatch!)")
+              << std::endl;
+    std::cout.flags(flags);
+    std::cout.precision(precision);
 }
 
 void ThreadSafetySample::demonstrate_async_futures() {
@@ -320,6 +513,51 @@ void ThreadSafetySample::demonstrate_async_futures() {
     std::thread task_thread(std::move(task), 15);
     std::cout << "Packaged task result: " << task_result.get() << std::endl;
     task_thread.join();
+
+    // Each std::async(std::launch::async) call above created an OS thread.
+    // A pool keeps its threads and hands out queue slots instead.
+    std::cout << "\nWork-stealing pool vs a thread per task:" << std::endl;
+    using ms = std::chrono::duration<double, std::milli>;
+    concurrency::work_stealing_pool pool;
+
+    constexpr int async_tasks = 1000;
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::future<int>> futures;
+        for (int i = 0; i < async_tasks; i++)
+            futures.push_back(std::async(std::launch::async, [i] { return i; }));
+        for (auto& f : futures)
+            f.get();
+    }
+    const ms async_time = std::chrono::steady_clock::now() - start;
+
+    constexpr int pool_tasks = 100000;
+    start = std::chrono::steady_clock::now();
+    std::vector<concurrency::pool_future<int>> futures;
+    futures.reserve(pool_tasks);
+    for (int i = 0; i < pool_tasks; i++)
+        futures.push_back(pool.submit([i] { return i; }));
+    const auto values = concurrency::when_all(std::move(futures)).get();
+    const ms pool_time = std::chrono::steady_clock::now() - start;
+
+    std::cout << "  std::async: " << async_tasks << " tasks in " << async_time.count() << " ms ("
+              << async_time.count() * 1000.0 / async_tasks << " us/task)" << std::endl;
+    std::cout << "  pool:       " << values.size() << " tasks in " << pool_time.count() << " ms ("
+              << pool_time.count() * 1000.0 / pool_tasks << " us/task, "
+              << pool.size() << " workers)" << std::endl;
+
+    // then(): the continuation is queued when the value arrives; nobody blocks
+    auto squared = pool.submit([] { return 12; }).then([](int x) { return x * x; });
+    auto described = std::move(squared).then([](int x) { return "12 squared is " + std::to_string(x); });
+    std::cout << "  then():     " << described.get() << std::endl;
+
+    // parallel_for: split in halves down to the grain, halves get stolen
+    std::vector<double> data(1 << 20, 0.5);
+    pool.parallel_for(0, data.size(), 4096, [&data](std::size_t i) { data[i] *= 2.0; });
+    std::cout << "  parallel_for doubled " << data.size() << " values, all 1.0: "
+              << std::boolalpha
+              << std::all_of(data.begin(), data.end(), [](double d) { return d == 1.0; })
+              << std::noboolalpha << std::endl;
 }
 
 void ThreadSafetySample::demonstrate_thread_safe_queue() {
@@ -432,5 +670,15 @@ void ThreadSafetySample::demonstrate_thread_safety_best_practices() {
     std::cout << "- Consider lock levels or addresses" << std::endl;
 }
 
+void ThreadSafetySample::demonstrate_contention_report() {
+    std::cout << "\n=== Lock Contention Report ===" << std::endl;
+    if constexpr (!concurrency::lock_profiling) {
+        std::cout << "Lock profiling compiled out (LOCK_PROFILING=0)" << std::endl;
+        return;
+    }
+    std::cout << "Every profiled_mutex site used so far, most total wait first:\n" << std::endl;
+    concurrency::contention_report(std::cout);
+}
+
 // Auto-register this sample
 REGISTER_SAMPLE(ThreadSafetySample, "Thread Safety", 15);
\ No newline at end of file
@@ -19,6 +19,7 @@ private:
     // Data Race Demonstration
     void demonstrate_data_race();
     void demonstrate_mutex_solution();
+    void demonstrate_hybrid_mutex();
     void demonstrate_atomic_solution();
 
     // Deadlock Prevention
@@ -37,6 +38,7 @@ private:
 
     // Best Practices
     void demonstrate_thread_safety_best_practices();
+    void demonstrate_contention_report();
 
     // Helper classes
     class BankAccount;
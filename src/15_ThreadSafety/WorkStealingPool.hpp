@@ -0,0 +1,545 @@
+#pragma once
+
+#include "SpinWait.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// Work-stealing thread pool with continuation-capable futures.
+//
+//   concurrency::work_stealing_pool pool;               // one worker per core
+//   auto f = pool.submit([] { return 6 * 7; });         // pool_future<int>
+//   auto g = std::move(f).then([](int x) { return x + 1; });   // runs on the pool
+//   auto all = concurrency::when_all(std::move(futures));      // pool_future<vector<T>>
+//   pool.parallel_for(0, n, 1024, [&](std::size_t i) { ... });
+//
+// Every worker owns a Chase-Lev deque. Tasks spawned on a worker are pushed to
+// the bottom of its own deque and popped LIFO, so they run while their data is
+// still in cache. Idle workers steal FIFO from the top of other deques, which
+// takes the oldest and usually largest pieces of work. Tasks from outside the
+// pool go through a mutex-protected injection queue. A submit therefore costs
+// one allocation and a few atomic operations, not the creation of an OS thread
+// as with std::async(std::launch::async, ...).
+
+namespace concurrency {
+
+class work_stealing_pool;
+
+namespace detail {
+
+// Type-erased task; one allocation per submit
+struct task {
+    virtual ~task() = default;
+    virtual void run() = 0;
+};
+
+template <class F> struct task_impl final : task {
+    explicit task_impl(F fn) : fn_(std::move(fn)) {}
+    void run() override { fn_(); }
+    F fn_;
+};
+
+template <class F> task* make_task(F&& fn) {
+    return new task_impl<std::decay_t<F>>(std::forward<F>(fn));
+}
+
+// Chase-Lev work-stealing deque of task pointers (Le, Pop, Cohen and Zappa
+// Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models",
+// PPoPP 2013). The owner calls push/pop at the bottom; any thread may call
+// steal at the top. The sequentially consistent store/load pairs on bottom and
+// top stand in for the paper's fences. When the ring grows, the old ring is
+// kept until the deque dies, because a thief may still be reading it.
+class ws_deque {
+public:
+    explicit ws_deque(std::int64_t capacity = 256)
+        : ring_(new ring(capacity)) {
+        retired_.emplace_back(ring_.load(std::memory_order_relaxed));
+    }
+
+    ws_deque(const ws_deque&) = delete;
+    ws_deque& operator=(const ws_deque&) = delete;
+
+    void push(task* t) {
+        const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        const std::int64_t top = top_.load(std::memory_order_acquire);
+        ring* r = ring_.load(std::memory_order_relaxed);
+        if (b - top >= r->capacity)
+            r = grow(r, top, b);
+        r->put(b, t);
+        bottom_.store(b + 1, std::memory_order_release);
+    }
+
+    task* pop() {
+        const std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        ring* r = ring_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_seq_cst);
+        std::int64_t top = top_.load(std::memory_order_seq_cst);
+        if (top > b) { // Empty
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        task* t = r->get(b);
+        if (top == b) { // Last element: race the thieves for it
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed))
+                t = nullptr;
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return t;
+    }
+
+    task* steal() {
+        std::int64_t top = top_.load(std::memory_order_seq_cst);
+        const std::int64_t b = bottom_.load(std::memory_order_seq_cst);
+        if (top >= b)
+            return nullptr;
+        task* t = ring_.load(std::memory_order_acquire)->get(top);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed))
+            return nullptr; // Lost to another thief or the owner
+        return t;
+    }
+
+    bool empty() const noexcept {
+        return top_.load(std::memory_order_relaxed) >= bottom_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct ring {
+        explicit ring(std::int64_t cap)
+            : capacity(cap), slots(std::make_unique<std::atomic<task*>[]>(static_cast<std::size_t>(cap))) {}
+
+        task* get(std::int64_t i) const noexcept {
+            return slots[static_cast<std::size_t>(i & (capacity - 1))].load(std::memory_order_relaxed);
+        }
+        void put(std::int64_t i, task* t) noexcept {
+            slots[static_cast<std::size_t>(i & (capacity - 1))].store(t, std::memory_order_relaxed);
+        }
+
+        std::int64_t capacity; // Power of two
+        std::unique_ptr<std::atomic<task*>[]> slots;
+    };
+
+    ring* grow(ring* old, std::int64_t top, std::int64_t bottom) {
+        auto bigger = std::make_unique<ring>(old->capacity * 2);
+        for (std::int64_t i = top; i < bottom; ++i)
+            bigger->put(i, old->get(i));
+        ring* r = bigger.get();
+        retired_.push_back(std::move(bigger));
+        ring_.store(r, std::memory_order_release);
+        return r;
+    }
+
+    alignas(cache_line_size) std::atomic<std::int64_t> top_{0};
+    alignas(cache_line_size) std::atomic<std::int64_t> bottom_{0};
+    std::atomic<ring*> ring_;
+    std::vector<std::unique_ptr<ring>> retired_; // Owner only
+};
+
+template <class T> using stored_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+// What a then() continuation returns: fn(T), or fn() after a void future
+template <class F, class T> struct continuation_result {
+    using type = std::invoke_result_t<F&, T>;
+};
+template <class F> struct continuation_result<F, void> {
+    using type = std::invoke_result_t<F&>;
+};
+
+// State shared by a pool_future and the task that fulfils it
+template <class T> struct shared_state {
+    explicit shared_state(work_stealing_pool* p) : pool(p) {}
+
+    template <class... V> void set_value(V&&... v) {
+        value.emplace(std::forward<V>(v)...);
+        finish();
+    }
+
+    void set_exception(std::exception_ptr e) {
+        error = std::move(e);
+        finish();
+    }
+
+    // Runs cb right away if already fulfilled, else on the fulfilling thread
+    void on_ready(std::move_only_function<void()> cb) {
+        {
+            std::lock_guard lock(mutex);
+            if (!ready.load(std::memory_order_relaxed)) {
+                callbacks.push_back(std::move(cb));
+                return;
+            }
+        }
+        cb();
+    }
+
+    work_stealing_pool* pool;
+    std::mutex mutex;
+    std::atomic<bool> ready{false};
+    std::optional<stored_t<T>> value;
+    std::exception_ptr error;
+    std::vector<std::move_only_function<void()>> callbacks;
+
+private:
+    void finish() {
+        std::vector<std::move_only_function<void()>> pending;
+        {
+            std::lock_guard lock(mutex);
+            ready.store(true, std::memory_order_release);
+            pending.swap(callbacks);
+        }
+        ready.notify_all();
+        for (auto& cb : pending)
+            cb();
+    }
+};
+
+// Calls fn and stores its result (or exception) into state
+template <class T, class F> void fulfil(shared_state<T>& state, F&& fn) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            std::forward<F>(fn)();
+            state.set_value();
+        } else {
+            state.set_value(std::forward<F>(fn)());
+        }
+    } catch (...) {
+        state.set_exception(std::current_exception());
+    }
+}
+
+} // namespace detail
+
+template <class T> class pool_future;
+
+template <class T>
+pool_future<std::vector<T>> when_all(std::vector<pool_future<T>> futures);
+
+class work_stealing_pool {
+public:
+    explicit work_stealing_pool(unsigned threads = std::max(1u, std::thread::hardware_concurrency())) {
+        workers_.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i)
+            workers_.push_back(std::make_unique<worker>());
+        for (unsigned i = 0; i < threads; ++i)
+            workers_[i]->thread = std::jthread([this, i] { worker_loop(i); });
+    }
+
+    work_stealing_pool(const work_stealing_pool&) = delete;
+    work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+    // Runs every task already submitted, then joins the workers
+    ~work_stealing_pool() {
+        stop_.store(true, std::memory_order_seq_cst);
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        epoch_.notify_all();
+        for (auto& w : workers_)
+            w->thread.join();
+    }
+
+    // Runs fn on the pool; the future receives its result or exception
+    template <class F> auto submit(F&& fn) -> pool_future<std::invoke_result_t<std::decay_t<F>&>> {
+        using R = std::invoke_result_t<std::decay_t<F>&>;
+        auto state = std::make_shared<detail::shared_state<R>>(this);
+        post([state, fn = std::forward<F>(fn)]() mutable { detail::fulfil(*state, fn); });
+        return pool_future<R>(std::move(state));
+    }
+
+    // Fire-and-forget; exceptions escaping fn terminate the program
+    template <class F> void post(F&& fn) { post_task(detail::make_task(std::forward<F>(fn))); }
+
+    // Calls body(i) for every i in [begin, end). The range is split in halves
+    // down to `grain` indices and the halves are left for other workers to
+    // steal; the calling thread works along until everything is done. The
+    // first exception thrown by body is rethrown here.
+    template <class Body>
+    void parallel_for(std::size_t begin, std::size_t end, std::size_t grain, Body&& body) {
+        if (begin >= end)
+            return;
+        for_job<std::remove_reference_t<Body>> job{body, std::max<std::size_t>(grain, 1), {end - begin}, {}, {}, {}};
+        split(job, begin, end);
+        while (job.remaining.load(std::memory_order_acquire) != 0)
+            if (!try_run_one())
+                std::this_thread::yield();
+        if (job.error)
+            std::rethrow_exception(job.error);
+    }
+
+    // Runs one queued task on the calling thread, if there is one. Lets a
+    // thread that waits for pool work help instead of blocking a worker.
+    bool try_run_one() {
+        task_ptr t = find_work(current_index());
+        if (!t)
+            return false;
+        t->run();
+        return true;
+    }
+
+    bool in_pool() const noexcept { return current_pool == this; }
+    std::size_t size() const noexcept { return workers_.size(); }
+
+private:
+    using task_ptr = std::unique_ptr<detail::task>;
+
+    struct worker {
+        detail::ws_deque deque;
+        std::jthread thread;
+    };
+
+    template <class Body> struct for_job {
+        Body& body;
+        std::size_t grain;
+        std::atomic<std::size_t> remaining;
+        std::atomic<bool> failed;
+        std::mutex error_mutex;
+        std::exception_ptr error;
+    };
+
+    // Keeps the left half, hands off right halves until the piece is small
+    template <class Body> void split(for_job<Body>& job, std::size_t begin, std::size_t end) {
+        while (end - begin > job.grain) {
+            const std::size_t mid = begin + (end - begin) / 2;
+            post([this, &job, mid, end] { split(job, mid, end); });
+            end = mid;
+        }
+        if (!job.failed.load(std::memory_order_relaxed)) {
+            try {
+                for (std::size_t i = begin; i < end; ++i)
+                    job.body(i);
+            } catch (...) {
+                std::lock_guard lock(job.error_mutex);
+                if (!job.failed.exchange(true))
+                    job.error = std::current_exception();
+            }
+        }
+        // Last touch of job: the waiter may return once this reaches zero
+        job.remaining.fetch_sub(end - begin, std::memory_order_acq_rel);
+    }
+
+    static constexpr std::size_t no_worker = static_cast<std::size_t>(-1);
+
+    std::size_t current_index() const noexcept {
+        return current_pool == this ? current_worker : no_worker;
+    }
+
+    void post_task(detail::task* raw) {
+        task_ptr t(raw);
+        if (const std::size_t self = current_index(); self != no_worker) {
+            workers_[self]->deque.push(t.release());
+        } else {
+            std::lock_guard lock(injection_mutex_);
+            injection_.push_back(std::move(t));
+            injected_.store(injection_.size(), std::memory_order_relaxed);
+        }
+        // Pairs with the sleeper's increment of sleeping_ followed by its
+        // final look at the queues: one of the two sides sees the other
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_relaxed) != 0) {
+            epoch_.fetch_add(1, std::memory_order_relaxed);
+            epoch_.notify_one();
+        }
+    }
+
+    task_ptr find_work(std::size_t self) {
+        if (self != no_worker)
+            if (detail::task* t = workers_[self]->deque.pop())
+                return task_ptr(t);
+        // Steal, starting at a different victim each time
+        const std::size_t n = workers_.size();
+        const std::size_t start = next_victim();
+        for (std::size_t k = 0; k < n; ++k) {
+            const std::size_t victim = (start + k) % n;
+            if (victim == self)
+                continue;
+            if (detail::task* t = workers_[victim]->deque.steal())
+                return task_ptr(t);
+        }
+        if (injected_.load(std::memory_order_relaxed) != 0) {
+            std::lock_guard lock(injection_mutex_);
+            if (!injection_.empty()) {
+                task_ptr t = std::move(injection_.front());
+                injection_.pop_front();
+                injected_.store(injection_.size(), std::memory_order_relaxed);
+                return t;
+            }
+        }
+        return nullptr;
+    }
+
+    static std::size_t next_victim() noexcept {
+        // xorshift; quality does not matter, only spreading thieves out
+        thread_local std::uint32_t x = 2463534242u ^ static_cast<std::uint32_t>(
+            std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        return x;
+    }
+
+    void worker_loop(std::size_t index) {
+        current_pool = this;
+        current_worker = index;
+        for (;;) {
+            if (task_ptr t = find_work(index)) {
+                t->run();
+                continue;
+            }
+            // Brief spin: new work often arrives within microseconds
+            if (spinning_useful()) {
+                task_ptr t;
+                for (int i = 0; i < 64 && !t; ++i) {
+                    cpu_relax();
+                    t = find_work(index);
+                }
+                if (t) {
+                    t->run();
+                    continue;
+                }
+            }
+            sleeping_.fetch_add(1, std::memory_order_seq_cst);
+            const std::uint32_t seen = epoch_.load(std::memory_order_seq_cst);
+            if (task_ptr t = find_work(index)) {
+                sleeping_.fetch_sub(1, std::memory_order_relaxed);
+                t->run();
+                continue;
+            }
+            if (stop_.load(std::memory_order_seq_cst)) {
+                sleeping_.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+            epoch_.wait(seen, std::memory_order_seq_cst);
+            sleeping_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    std::vector<std::unique_ptr<worker>> workers_;
+    std::mutex injection_mutex_;
+    std::deque<task_ptr> injection_;
+    std::atomic<std::size_t> injected_{0};
+    alignas(cache_line_size) std::atomic<std::uint32_t> sleeping_{0};
+    std::atomic<std::uint32_t> epoch_{0};
+    std::atomic<bool> stop_{false};
+
+    static inline thread_local const work_stealing_pool* current_pool = nullptr;
+    static inline thread_local std::size_t current_worker = 0;
+};
+
+// Result of work_stealing_pool::submit. Unlike std::future it can be chained
+// with then(); the continuation is scheduled on the pool when the value
+// arrives, so no thread sits blocked in get() waiting for it.
+template <class T> class pool_future {
+public:
+    pool_future() = default;
+
+    bool valid() const noexcept { return state_ != nullptr; }
+    bool is_ready() const noexcept { return state_->ready.load(std::memory_order_acquire); }
+
+    // On a pool thread, waiting runs other pool tasks instead of blocking
+    void wait() const {
+        work_stealing_pool* pool = state_->pool;
+        if (pool && pool->in_pool()) {
+            while (!is_ready())
+                if (!pool->try_run_one())
+                    std::this_thread::yield();
+        } else {
+            state_->ready.wait(false, std::memory_order_acquire);
+        }
+    }
+
+    T get() {
+        wait();
+        auto state = std::move(state_);
+        if (state->error)
+            std::rethrow_exception(state->error);
+        if constexpr (!std::is_void_v<T>)
+            return std::move(*state->value);
+    }
+
+    // fn receives the value (nothing for void) and runs on the pool. If this
+    // future holds an exception, fn is skipped and the exception is passed on.
+    // A future with no pool (when_all of nothing) runs fn inline instead.
+    template <class F> auto then(F&& fn) && {
+        using R = typename detail::continuation_result<std::decay_t<F>, T>::type;
+        auto next = std::make_shared<detail::shared_state<R>>(state_->pool);
+        auto prev = std::move(state_);
+        auto* raw = prev.get();
+        raw->on_ready([prev, next, fn = std::forward<F>(fn)]() mutable {
+            work_stealing_pool* pool = prev->pool;
+            auto step = [prev = std::move(prev), next = std::move(next), fn = std::move(fn)]() mutable {
+                if (prev->error)
+                    return next->set_exception(prev->error);
+                detail::fulfil(*next, [&]() -> R {
+                    if constexpr (std::is_void_v<T>)
+                        return fn();
+                    else
+                        return fn(std::move(*prev->value));
+                });
+            };
+            if (pool)
+                pool->post(std::move(step));
+            else
+                step();
+        });
+        return pool_future<R>(std::move(next));
+    }
+
+private:
+    friend class work_stealing_pool;
+    template <class U> friend class pool_future;
+    template <class U> friend pool_future<std::vector<U>> when_all(std::vector<pool_future<U>>);
+
+    explicit pool_future(std::shared_ptr<detail::shared_state<T>> state) : state_(std::move(state)) {}
+
+    std::shared_ptr<detail::shared_state<T>> state_;
+};
+
+// Ready when every input is. Holds the values in input order, or the
+// exception of the first failed input
+template <class T>
+pool_future<std::vector<T>> when_all(std::vector<pool_future<T>> futures) {
+    static_assert(!std::is_void_v<T>, "when_all collects values");
+    work_stealing_pool* pool = futures.empty() ? nullptr : futures.front().state_->pool;
+    auto result = std::make_shared<detail::shared_state<std::vector<T>>>(pool);
+    if (futures.empty()) {
+        result->set_value();
+        return pool_future<std::vector<T>>(std::move(result));
+    }
+
+    struct gather {
+        std::vector<std::shared_ptr<detail::shared_state<T>>> inputs;
+        std::atomic<std::size_t> remaining;
+    };
+    auto g = std::make_shared<gather>();
+    g->remaining.store(futures.size(), std::memory_order_relaxed);
+    for (auto& f : futures)
+        g->inputs.push_back(std::move(f.state_));
+
+    for (auto& input : g->inputs) {
+        input->on_ready([g, result] {
+            if (g->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+            std::vector<T> values;
+            values.reserve(g->inputs.size());
+            for (auto& in : g->inputs) {
+                if (in->error)
+                    return result->set_exception(in->error);
+                values.push_back(std::move(*in->value));
+            }
+            result->set_value(std::move(values));
+        });
+    }
+    return pool_future<std::vector<T>>(std::move(result));
+}
+
+} // namespace concurrency
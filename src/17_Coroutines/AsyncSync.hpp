@@ -0,0 +1,383 @@
+#pragma once
+
+#include "AsyncTask.hpp"
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+namespace coro {
+
+// ============================================================================
+// Synchronisation primitives for coroutines
+// ============================================================================
+// A std::mutex must not be held across a co_await (the coroutine may resume
+// on another thread), and blocking on one stalls the executor thread. These
+// primitives suspend the coroutine instead:
+//
+//   coro::AsyncMutex mutex(pool);
+//   auto lock = co_await mutex.lock();     // scoped: unlocks on destruction
+//
+//   coro::AsyncSemaphore limit(pool, 8);   // at most 8 requests in flight
+//   auto permit = co_await limit.scoped_acquire();
+//
+//   coro::AsyncLatch ready(pool, workers); // ready.count_down() in each worker
+//   co_await ready.wait();
+//
+// The uncontended path is a single atomic operation. Waiters are served in
+// FIFO order and are always resumed by posting them to the ThreadPool given
+// at construction, never inline: unlock(), release() and set() return
+// straight away instead of running other coroutines on the caller's stack.
+
+// ============================================================================
+// AsyncMutex
+// ============================================================================
+// The lock-free design of cppcoro's async_mutex. state_ is either
+// `not_locked`, `locked_no_waiters`, or a pointer to a stack (LIFO) of
+// newly arrived waiters. Only the holder touches waiters_: on unlock it
+// moves the stack over in reverse, which restores arrival order, and hands
+// the lock directly to the oldest waiter.
+
+class AsyncMutex;
+
+// Owns a locked AsyncMutex; unlocks on destruction
+class AsyncMutexLock {
+public:
+    AsyncMutexLock(AsyncMutex& mutex, std::adopt_lock_t) noexcept : mutex_(&mutex) {}
+    AsyncMutexLock(AsyncMutexLock&& other) noexcept : mutex_(std::exchange(other.mutex_, nullptr)) {}
+    AsyncMutexLock& operator=(AsyncMutexLock&& other) noexcept {
+        if (this != &other) {
+            unlock();
+            mutex_ = std::exchange(other.mutex_, nullptr);
+        }
+        return *this;
+    }
+    ~AsyncMutexLock() { unlock(); }
+
+    void unlock() noexcept;
+    bool owns_lock() const noexcept { return mutex_ != nullptr; }
+
+private:
+    AsyncMutex* mutex_;
+};
+
+class AsyncMutex {
+public:
+    explicit AsyncMutex(ThreadPool& executor) noexcept : executor_(executor) {}
+
+    AsyncMutex(const AsyncMutex&) = delete;
+    AsyncMutex& operator=(const AsyncMutex&) = delete;
+
+    class LockAwaiter {
+    public:
+        explicit LockAwaiter(AsyncMutex& mutex) noexcept : mutex_(mutex) {}
+
+        bool await_ready() noexcept { return mutex_.try_lock(); }
+
+        bool await_suspend(std::coroutine_handle<> h) noexcept {
+            handle_ = h;
+            std::uintptr_t old = mutex_.state_.load(std::memory_order_acquire);
+            for (;;) {
+                if (old == not_locked) {
+                    // Released meanwhile: take it and do not suspend
+                    if (mutex_.state_.compare_exchange_weak(old, locked_no_waiters, std::memory_order_acquire,
+                                                            std::memory_order_acquire))
+                        return false;
+                    continue;
+                }
+                next_ = old == locked_no_waiters ? nullptr : reinterpret_cast<LockAwaiter*>(old);
+                if (mutex_.state_.compare_exchange_weak(old, reinterpret_cast<std::uintptr_t>(this),
+                                                        std::memory_order_release, std::memory_order_acquire))
+                    return true; // unlock() may resume us before this returns
+            }
+        }
+
+        AsyncMutexLock await_resume() noexcept { return AsyncMutexLock(mutex_, std::adopt_lock); }
+
+    private:
+        friend class AsyncMutex;
+        AsyncMutex& mutex_;
+        std::coroutine_handle<> handle_;
+        LockAwaiter* next_ = nullptr;
+    };
+
+    // co_await mutex.lock() -> AsyncMutexLock
+    [[nodiscard]] LockAwaiter lock() noexcept { return LockAwaiter{*this}; }
+
+    bool try_lock() noexcept {
+        std::uintptr_t expected = not_locked;
+        return state_.compare_exchange_strong(expected, locked_no_waiters, std::memory_order_acquire,
+                                              std::memory_order_relaxed);
+    }
+
+    // Must be called by the holder. With waiters, ownership passes to the
+    // oldest one and the mutex stays locked.
+    void unlock() {
+        LockAwaiter* head = waiters_;
+        if (head == nullptr) {
+            std::uintptr_t expected = locked_no_waiters;
+            if (state_.compare_exchange_strong(expected, not_locked, std::memory_order_release,
+                                               std::memory_order_relaxed))
+                return;
+            // Take every waiter that arrived since, newest first, and reverse
+            auto* stack =
+                reinterpret_cast<LockAwaiter*>(state_.exchange(locked_no_waiters, std::memory_order_acquire));
+            while (stack != nullptr) {
+                LockAwaiter* next = stack->next_;
+                stack->next_ = head;
+                head = stack;
+                stack = next;
+            }
+        }
+        waiters_ = head->next_;
+        executor_.post(head->handle_);
+    }
+
+private:
+    static constexpr std::uintptr_t not_locked = 1;
+    static constexpr std::uintptr_t locked_no_waiters = 0;
+
+    std::atomic<std::uintptr_t> state_{not_locked};
+    LockAwaiter* waiters_ = nullptr; // FIFO, owned by the holder
+    ThreadPool& executor_;
+};
+
+inline void AsyncMutexLock::unlock() noexcept {
+    if (mutex_ != nullptr)
+        std::exchange(mutex_, nullptr)->unlock();
+}
+
+// ============================================================================
+// AsyncSemaphore
+// ============================================================================
+// count_ is the number of free permits, or minus the number of waiters.
+// acquire and release are one fetch_sub / fetch_add while permits are free.
+// Only when they cross zero do they take a mutex, to queue a waiter or to
+// pass a permit to one. A release that finds the waiter not yet queued
+// leaves the permit in handoffs_, and the waiter takes it instead of
+// suspending.
+
+class AsyncSemaphore;
+
+// Owns one permit; releases it on destruction
+class AsyncSemaphorePermit {
+public:
+    explicit AsyncSemaphorePermit(AsyncSemaphore& semaphore) noexcept : semaphore_(&semaphore) {}
+    AsyncSemaphorePermit(AsyncSemaphorePermit&& other) noexcept
+        : semaphore_(std::exchange(other.semaphore_, nullptr)) {}
+    AsyncSemaphorePermit& operator=(AsyncSemaphorePermit&& other) noexcept {
+        if (this != &other) {
+            release();
+            semaphore_ = std::exchange(other.semaphore_, nullptr);
+        }
+        return *this;
+    }
+    ~AsyncSemaphorePermit() { release(); }
+
+    void release() noexcept;
+
+private:
+    AsyncSemaphore* semaphore_;
+};
+
+class AsyncSemaphore {
+public:
+    AsyncSemaphore(ThreadPool& executor, std::ptrdiff_t permits) noexcept
+        : count_(permits), executor_(executor) {}
+
+    AsyncSemaphore(const AsyncSemaphore&) = delete;
+    AsyncSemaphore& operator=(const AsyncSemaphore&) = delete;
+
+    class AcquireAwaiter {
+    public:
+        explicit AcquireAwaiter(AsyncSemaphore& semaphore) noexcept : semaphore_(semaphore) {}
+
+        // Either takes a permit or registers as a waiter; no way back
+        bool await_ready() noexcept {
+            return semaphore_.count_.fetch_sub(1, std::memory_order_acquire) > 0;
+        }
+
+        bool await_suspend(std::coroutine_handle<> h) {
+            std::lock_guard lock(semaphore_.mutex_);
+            if (semaphore_.handoffs_ > 0) {
+                --semaphore_.handoffs_;
+                return false;
+            }
+            handle_ = h;
+            (semaphore_.tail_ ? semaphore_.tail_->next_ : semaphore_.head_) = this;
+            semaphore_.tail_ = this;
+            return true;
+        }
+
+        void await_resume() const noexcept {}
+
+    protected:
+        AsyncSemaphore& semaphore_;
+
+    private:
+        friend class AsyncSemaphore;
+        std::coroutine_handle<> handle_;
+        AcquireAwaiter* next_ = nullptr;
+    };
+
+    class ScopedAcquireAwaiter : public AcquireAwaiter {
+    public:
+        using AcquireAwaiter::AcquireAwaiter;
+        AsyncSemaphorePermit await_resume() const noexcept { return AsyncSemaphorePermit(semaphore_); }
+    };
+
+    // co_await semaphore.acquire(); ... semaphore.release();
+    [[nodiscard]] AcquireAwaiter acquire() noexcept { return AcquireAwaiter{*this}; }
+
+    // co_await semaphore.scoped_acquire() -> AsyncSemaphorePermit
+    [[nodiscard]] ScopedAcquireAwaiter scoped_acquire() noexcept { return ScopedAcquireAwaiter{*this}; }
+
+    bool try_acquire() noexcept {
+        std::ptrdiff_t free = count_.load(std::memory_order_relaxed);
+        while (free > 0) {
+            if (count_.compare_exchange_weak(free, free - 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+
+    void release(std::ptrdiff_t permits = 1) {
+        for (; permits > 0; --permits) {
+            if (count_.fetch_add(1, std::memory_order_release) >= 0)
+                continue; // Nobody waiting
+            std::coroutine_handle<> next;
+            {
+                std::lock_guard lock(mutex_);
+                if (AcquireAwaiter* waiter = head_) {
+                    head_ = waiter->next_;
+                    if (head_ == nullptr)
+                        tail_ = nullptr;
+                    next = waiter->handle_;
+                } else {
+                    ++handoffs_; // The waiter is between await_ready and await_suspend
+                }
+            }
+            if (next)
+                executor_.post(next);
+        }
+    }
+
+    // Free permits; negative when coroutines are waiting
+    std::ptrdiff_t available() const noexcept { return count_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::ptrdiff_t> count_;
+    std::mutex mutex_; // Guards the waiter list and handoffs_
+    AcquireAwaiter* head_ = nullptr;
+    AcquireAwaiter* tail_ = nullptr;
+    std::ptrdiff_t handoffs_ = 0;
+    ThreadPool& executor_;
+};
+
+inline void AsyncSemaphorePermit::release() noexcept {
+    if (semaphore_ != nullptr)
+        std::exchange(semaphore_, nullptr)->release();
+}
+
+// ============================================================================
+// AsyncEvent - manual-reset event
+// ============================================================================
+// state_ is `this` when set, nullptr when not set with no waiters, or a
+// stack of waiters. set() swaps in `this` and posts the whole stack, oldest
+// first.
+
+class AsyncEvent {
+public:
+    explicit AsyncEvent(ThreadPool& executor, bool initially_set = false) noexcept
+        : state_(initially_set ? this : nullptr), executor_(executor) {}
+
+    AsyncEvent(const AsyncEvent&) = delete;
+    AsyncEvent& operator=(const AsyncEvent&) = delete;
+
+    class WaitAwaiter {
+    public:
+        explicit WaitAwaiter(AsyncEvent& event) noexcept : event_(event) {}
+
+        bool await_ready() const noexcept { return event_.is_set(); }
+
+        bool await_suspend(std::coroutine_handle<> h) noexcept {
+            handle_ = h;
+            void* old = event_.state_.load(std::memory_order_acquire);
+            do {
+                if (old == &event_)
+                    return false; // Set meanwhile
+                next_ = static_cast<WaitAwaiter*>(old);
+            } while (!event_.state_.compare_exchange_weak(old, this, std::memory_order_release,
+                                                          std::memory_order_acquire));
+            return true;
+        }
+
+        void await_resume() const noexcept {}
+
+    private:
+        friend class AsyncEvent;
+        AsyncEvent& event_;
+        std::coroutine_handle<> handle_;
+        WaitAwaiter* next_ = nullptr;
+    };
+
+    [[nodiscard]] WaitAwaiter wait() noexcept { return WaitAwaiter{*this}; }
+
+    bool is_set() const noexcept { return state_.load(std::memory_order_acquire) == this; }
+
+    void set() {
+        void* old = state_.exchange(this, std::memory_order_acq_rel);
+        if (old == this)
+            return;
+        WaitAwaiter* fifo = nullptr;
+        for (auto* w = static_cast<WaitAwaiter*>(old); w != nullptr;) {
+            WaitAwaiter* next = w->next_;
+            w->next_ = fifo;
+            fifo = w;
+            w = next;
+        }
+        while (fifo != nullptr) {
+            // Read next before posting: the waiter and its node may be gone after
+            WaitAwaiter* next = fifo->next_;
+            executor_.post(fifo->handle_);
+            fifo = next;
+        }
+    }
+
+    // No effect unless set
+    void reset() noexcept {
+        void* expected = this;
+        state_.compare_exchange_strong(expected, nullptr, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<void*> state_;
+    ThreadPool& executor_;
+};
+
+// ============================================================================
+// AsyncLatch - single-use countdown
+// ============================================================================
+
+class AsyncLatch {
+public:
+    AsyncLatch(ThreadPool& executor, std::ptrdiff_t count) noexcept
+        : count_(count), event_(executor, count <= 0) {}
+
+    void count_down(std::ptrdiff_t n = 1) {
+        if (count_.fetch_sub(n, std::memory_order_acq_rel) == n)
+            event_.set();
+    }
+
+    bool try_wait() const noexcept { return event_.is_set(); }
+
+    [[nodiscard]] AsyncEvent::WaitAwaiter wait() noexcept { return event_.wait(); }
+
+private:
+    std::atomic<std::ptrdiff_t> count_;
+    AsyncEvent event_;
+};
+
+} // namespace coro
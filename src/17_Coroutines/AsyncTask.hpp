@@ -0,0 +1,548 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <semaphore>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace coro {
+
+// ============================================================================
+// Lazy, awaitable Task<T> with stop-token propagation
+// ============================================================================
+// Unlike the eager demo Task in CoroutinesSample.cpp, this Task does nothing
+// until it is awaited (or handed to sync_wait). Awaiting it transfers control
+// symmetrically into the child and back, and the child inherits the
+// awaiter's std::stop_token, so cancelling a root task reaches every awaiter
+// below it that checks the token.
+
+using Clock = std::chrono::steady_clock;
+
+// Thrown out of cancellable awaiters once the task's stop token fires
+class operation_cancelled : public std::runtime_error {
+public:
+    operation_cancelled() : std::runtime_error("operation cancelled") {}
+};
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+template <typename Promise>
+concept HasStopToken = requires(Promise& p) {
+    { p.stop_token } -> std::convertible_to<std::stop_token>;
+};
+
+template <typename Promise>
+std::stop_token stop_token_of(std::coroutine_handle<Promise> h) noexcept {
+    if constexpr (HasStopToken<Promise>) {
+        return h.promise().stop_token;
+    } else {
+        return {};
+    }
+}
+
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+    std::exception_ptr exception;
+    std::stop_token stop_token;
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept {
+            return h.promise().continuation;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    void unhandled_exception() noexcept { exception = std::current_exception(); }
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase {
+    std::optional<T> result;
+
+    Task<T> get_return_object() noexcept;
+
+    template <typename U = T>
+        requires std::convertible_to<U&&, T>
+    void return_value(U&& value) {
+        result.emplace(std::forward<U>(value));
+    }
+
+    T take() {
+        if (exception) std::rethrow_exception(exception);
+        return std::move(*result);
+    }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object() noexcept;
+
+    void return_void() noexcept {}
+
+    void take() {
+        if (exception) std::rethrow_exception(exception);
+    }
+};
+
+} // namespace detail
+
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using handle_type = std::coroutine_handle<promise_type>;
+    using value_type = T;
+
+    Task() = default;
+    explicit Task(handle_type h) noexcept : handle_(h) {}
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    ~Task() {
+        if (handle_) handle_.destroy();
+    }
+
+    struct Awaiter {
+        handle_type handle;
+
+        bool await_ready() const noexcept { return !handle || handle.done(); }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> awaiting) noexcept {
+            auto& promise = handle.promise();
+            promise.continuation = awaiting;
+            if (!promise.stop_token.stop_possible()) {
+                promise.stop_token = detail::stop_token_of(awaiting);
+            }
+            return handle;
+        }
+
+        T await_resume() {
+            if (!handle) throw std::logic_error("coro::Task: awaiting an empty task");
+            return handle.promise().take();
+        }
+    };
+
+    Awaiter operator co_await() const noexcept { return Awaiter{handle_}; }
+
+    // An explicit token wins over the one inherited from the awaiter
+    void set_stop_token(std::stop_token token) noexcept {
+        handle_.promise().stop_token = std::move(token);
+    }
+
+    bool done() const noexcept { return !handle_ || handle_.done(); }
+
+private:
+    handle_type handle_ = nullptr;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+}
+
+} // namespace detail
+
+// ============================================================================
+// Reading the current stop token
+// ============================================================================
+
+// co_await get_stop_token() yields the calling task's token without suspending
+struct GetStopTokenAwaiter {
+    std::stop_token token;
+
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> h) noexcept {
+        token = detail::stop_token_of(h);
+        return false;
+    }
+
+    std::stop_token await_resume() noexcept { return std::move(token); }
+};
+
+inline GetStopTokenAwaiter get_stop_token() noexcept { return {}; }
+
+// co_await cancellation_point() throws operation_cancelled if stop was requested
+struct CancellationPointAwaiter {
+    bool cancelled = false;
+
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> h) noexcept {
+        cancelled = detail::stop_token_of(h).stop_requested();
+        return false;
+    }
+
+    void await_resume() const {
+        if (cancelled) throw operation_cancelled{};
+    }
+};
+
+inline CancellationPointAwaiter cancellation_point() noexcept { return {}; }
+
+// ============================================================================
+// sync_wait - block the calling thread until a task completes
+// ============================================================================
+
+namespace detail {
+
+struct SyncWaitTask {
+    struct promise_type {
+        std::binary_semaphore* done = nullptr;
+
+        SyncWaitTask get_return_object() noexcept {
+            return SyncWaitTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                h.promise().done->release();
+            }
+            void await_resume() const noexcept {}
+        };
+
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }  // Body catches everything
+    };
+
+    explicit SyncWaitTask(std::coroutine_handle<promise_type> h) noexcept : handle(h) {}
+    SyncWaitTask(SyncWaitTask&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    ~SyncWaitTask() {
+        if (handle) handle.destroy();
+    }
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+struct Unit {};
+
+template <typename T>
+using NonVoid = std::conditional_t<std::is_void_v<T>, Unit, T>;
+
+template <typename T>
+SyncWaitTask make_sync_wait(Task<T>& task, std::optional<NonVoid<T>>& out, std::exception_ptr& error) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await task;
+            out.emplace();
+        } else {
+            out.emplace(co_await task);
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+}
+
+} // namespace detail
+
+// Runs the task on the calling thread until it first suspends, then blocks
+// until whichever thread finishes it signals completion.
+template <typename T>
+T sync_wait(Task<T> task, std::stop_token token = {}) {
+    if (token.stop_possible()) task.set_stop_token(std::move(token));
+
+    std::optional<detail::NonVoid<T>> out;
+    std::exception_ptr error;
+    std::binary_semaphore done{0};
+
+    auto waiter = detail::make_sync_wait(task, out, error);
+    waiter.handle.promise().done = &done;
+    waiter.handle.resume();
+    done.acquire();
+
+    if (error) std::rethrow_exception(error);
+    if constexpr (!std::is_void_v<T>) {
+        return std::move(*out);
+    }
+}
+
+// ============================================================================
+// ThreadPool - an executor coroutines can hop onto
+// ============================================================================
+
+class ThreadPool {
+public:
+    explicit ThreadPool(std::size_t threads = std::max(1u, std::thread::hardware_concurrency())) {
+        workers_.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this](std::stop_token st) { run(st); });
+        }
+    }
+
+    // Drains everything already posted, then joins the workers
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        workers_.clear();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void post(std::coroutine_handle<> h) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(h);
+        }
+        cv_.notify_one();
+    }
+
+    // co_await pool.schedule() continues the coroutine on a pool thread
+    auto schedule() noexcept {
+        struct ScheduleAwaiter {
+            ThreadPool& pool;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { pool.post(h); }
+            void await_resume() const noexcept {}
+        };
+        return ScheduleAwaiter{*this};
+    }
+
+    std::size_t size() const noexcept { return workers_.size(); }
+
+private:
+    void run(std::stop_token) {
+        for (;;) {
+            std::coroutine_handle<> next;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return !queue_.empty() || stopping_; });
+                if (queue_.empty()) return;
+                next = queue_.front();
+                queue_.pop_front();
+            }
+            next.resume();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::coroutine_handle<>> queue_;
+    bool stopping_ = false;
+    std::vector<std::jthread> workers_;
+};
+
+// ============================================================================
+// TimerService and cancellable sleep
+// ============================================================================
+// One background thread owns a deadline heap. A sleeping coroutine is
+// resumed either by that thread when its deadline passes or by whichever
+// thread requests stop on its token, whichever claims it first.
+
+namespace detail {
+
+struct TimerState {
+    enum : int { Arming, Armed, Fired, Cancelled };
+
+    explicit TimerState(std::coroutine_handle<> h) noexcept : handle(h) {}
+
+    // Armed -> Fired. The winner of the claim resumes the coroutine.
+    bool fire() noexcept {
+        int expected = Armed;
+        return status.compare_exchange_strong(expected, Fired, std::memory_order_acq_rel);
+    }
+
+    // Armed -> Cancelled (caller resumes), or Arming -> Cancelled (the
+    // suspending awaiter notices and does not suspend at all).
+    bool cancel() noexcept {
+        int expected = Armed;
+        if (status.compare_exchange_strong(expected, Cancelled, std::memory_order_acq_rel)) return true;
+        if (expected == Arming) {
+            status.compare_exchange_strong(expected, Cancelled, std::memory_order_acq_rel);
+        }
+        return false;
+    }
+
+    std::coroutine_handle<> handle;
+    std::atomic<int> status{Arming};
+};
+
+} // namespace detail
+
+class TimerService {
+public:
+    static TimerService& instance() {
+        static TimerService service;
+        return service;
+    }
+
+    void add(Clock::time_point deadline, std::shared_ptr<detail::TimerState> state) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            timers_.push(Entry{deadline, nextSequence_++, std::move(state)});
+        }
+        cv_.notify_one();
+    }
+
+    ~TimerService() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_one();
+        if (thread_.joinable()) thread_.join();
+    }
+
+    TimerService(const TimerService&) = delete;
+    TimerService& operator=(const TimerService&) = delete;
+
+private:
+    struct Entry {
+        Clock::time_point deadline;
+        std::uint64_t sequence;
+        std::shared_ptr<detail::TimerState> state;
+
+        bool operator>(const Entry& other) const {
+            return deadline != other.deadline ? deadline > other.deadline : sequence > other.sequence;
+        }
+    };
+
+    TimerService() : thread_([this] { run(); }) {}
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            if (timers_.empty()) {
+                cv_.wait(lock);
+                continue;
+            }
+            const auto deadline = timers_.top().deadline;
+            if (Clock::now() < deadline) {
+                cv_.wait_until(lock, deadline);
+                continue;
+            }
+            auto state = timers_.top().state;
+            timers_.pop();
+            lock.unlock();
+            if (state->fire()) state->handle.resume();  // Cancelled entries are simply dropped
+            lock.lock();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> timers_;
+    std::uint64_t nextSequence_ = 0;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+// Deadline-aware sleep. Throws operation_cancelled from co_await when the
+// task's stop token fires first.
+class SleepAwaiter {
+public:
+    explicit SleepAwaiter(Clock::time_point deadline) noexcept : deadline_(deadline) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    bool await_suspend(std::coroutine_handle<Promise> h) {
+        std::stop_token token = detail::stop_token_of(h);
+        if (token.stop_requested()) {
+            cancelled_ = true;
+            return false;
+        }
+        if (deadline_ <= Clock::now()) return false;
+
+        const auto deadline = deadline_;
+        auto state = std::make_shared<detail::TimerState>(h);
+        state_ = state;
+        if (token.stop_possible()) onStop_.emplace(std::move(token), Canceller{state});
+
+        int expected = detail::TimerState::Arming;
+        if (!state->status.compare_exchange_strong(expected, detail::TimerState::Armed,
+                                                   std::memory_order_acq_rel)) {
+            cancelled_ = true;  // Stop arrived while arming; continue without suspending
+            return false;
+        }
+        // From here on the coroutine may already be resumed by a canceller,
+        // so only locals are touched.
+        TimerService::instance().add(deadline, std::move(state));
+        return true;
+    }
+
+    void await_resume() {
+        onStop_.reset();
+        if (cancelled_ || (state_ && state_->status.load(std::memory_order_acquire) ==
+                                         detail::TimerState::Cancelled)) {
+            throw operation_cancelled{};
+        }
+    }
+
+private:
+    struct Canceller {
+        std::shared_ptr<detail::TimerState> state;
+        void operator()() const noexcept {
+            if (state->cancel()) state->handle.resume();
+        }
+    };
+
+    Clock::time_point deadline_;
+    bool cancelled_ = false;
+    std::shared_ptr<detail::TimerState> state_;
+    std::optional<std::stop_callback<Canceller>> onStop_;
+};
+
+inline SleepAwaiter sleep_until(Clock::time_point deadline) noexcept {
+    return SleepAwaiter{deadline};
+}
+
+template <typename Rep, typename Period>
+SleepAwaiter sleep_for(std::chrono::duration<Rep, Period> duration) noexcept {
+    return SleepAwaiter{Clock::now() + std::chrono::duration_cast<Clock::duration>(duration)};
+}
+
+} // namespace coro
@@ -0,0 +1,520 @@
+#pragma once
+
+#include "AsyncTask.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace coro {
+
+// ============================================================================
+// Channel<T> - Go-style bounded channel for coroutines
+// ============================================================================
+// BoundedQueue::pop() blocks a thread on a condition variable. A Channel
+// instead suspends the coroutine: a full send or an empty receive parks the
+// awaiter in the channel and the thread goes on to run other coroutines.
+//
+//   coro::Channel<int> ch(16, &pool);               // capacity 0 = rendezvous
+//   bool sent = co_await ch.send(42);               // false once closed
+//   std::optional<int> v = co_await ch.receive();   // nullopt once closed and drained
+//   ch.close();                                     // like BoundedQueue::shutdown()
+//
+//   auto r = co_await coro::select(a.receive_case(), b.send_case(x));
+//   if (r.index() == 0) use(std::get<0>(r));        // whichever case fired first
+//
+// When an operation completes a parked partner (a send meeting a waiting
+// receiver, a receive freeing a blocked sender), the partner is resumed
+// through symmetric transfer: the current thread jumps straight into it
+// while the value is still in cache, and the current coroutine is posted to
+// the channel's ThreadPool. Without a pool the partner runs on the current
+// thread first (see resume_inline) and the current coroutine continues after.
+//
+// A mutex guards the buffer and the waiter lists. It is held only inside the
+// awaiter calls, never while a coroutine body runs.
+
+namespace detail {
+
+// Intrusive list node for a parked operation. Lives in the awaiter, which
+// lives in the suspended coroutine's frame.
+struct ChannelWaiter {
+    ChannelWaiter* prev = nullptr;
+    ChannelWaiter* next = nullptr;
+    std::coroutine_handle<> handle;
+    // Shared by all cases of one select; only the first claim succeeds
+    std::atomic<bool>* select_done = nullptr;
+    bool linked = false;
+    bool fired = false;
+    bool ok = false; // false: completed by close()
+
+    bool claim() noexcept {
+        return select_done == nullptr || !select_done->exchange(true, std::memory_order_acq_rel);
+    }
+};
+
+class WaiterList {
+public:
+    void push_back(ChannelWaiter* w) noexcept {
+        w->prev = tail_;
+        w->next = nullptr;
+        (tail_ ? tail_->next : head_) = w;
+        tail_ = w;
+        w->linked = true;
+    }
+
+    void unlink(ChannelWaiter* w) noexcept {
+        (w->prev ? w->prev->next : head_) = w->next;
+        (w->next ? w->next->prev : tail_) = w->prev;
+        w->prev = w->next = nullptr;
+        w->linked = false;
+    }
+
+    // Oldest waiter that can still be claimed; stale select cases are dropped
+    ChannelWaiter* pop_claimed() noexcept {
+        while (ChannelWaiter* w = head_) {
+            unlink(w);
+            if (w->claim())
+                return w;
+        }
+        return nullptr;
+    }
+
+private:
+    ChannelWaiter* head_ = nullptr;
+    ChannelWaiter* tail_ = nullptr;
+};
+
+enum class ChannelStatus { Done, Closed, WouldBlock };
+
+// Without an executor, woken coroutines run on the waking thread. Resuming
+// them directly would nest: a woken sender wakes a receiver, which wakes the
+// next sender... and the stack grows with every hand-off. Instead only the
+// outermost wake-up on a thread resumes; anything woken while it runs is
+// queued and run by that outermost call once the current chain suspends.
+inline void resume_inline(std::coroutine_handle<> h) {
+    struct RunQueue {
+        bool draining = false;
+        std::deque<std::coroutine_handle<>> ready;
+    };
+    thread_local RunQueue queue;
+    if (queue.draining) {
+        queue.ready.push_back(h);
+        return;
+    }
+    queue.draining = true;
+    h.resume();
+    while (!queue.ready.empty()) {
+        const auto next = queue.ready.front();
+        queue.ready.pop_front();
+        next.resume();
+    }
+    queue.draining = false;
+}
+
+// An operation completed and unparked `partner` (or nobody). Returns true if
+// the caller can carry on without suspending; false means suspend and jump
+// to the partner through symmetric transfer while the executor picks the
+// caller up again.
+inline bool hand_off(ThreadPool* executor, std::coroutine_handle<> partner,
+                     std::coroutine_handle<>& transfer_to) {
+    if (!partner)
+        return true;
+    if (executor) {
+        transfer_to = partner;
+        return false;
+    }
+    resume_inline(partner);
+    return true;
+}
+
+} // namespace detail
+
+template <typename T>
+class Channel {
+    struct SendWaiter : detail::ChannelWaiter {
+        T* value = nullptr;
+    };
+    struct ReceiveWaiter : detail::ChannelWaiter {
+        std::optional<T>* slot = nullptr;
+    };
+
+    // What an operation did, and which parked partner now needs resuming
+    struct Outcome {
+        detail::ChannelStatus status;
+        std::coroutine_handle<> partner = nullptr;
+    };
+
+public:
+    explicit Channel(std::size_t capacity = 0, ThreadPool* executor = nullptr)
+        : capacity_(capacity), executor_(executor) {}
+
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    // The operation is attempted in await_ready, so one that completes at
+    // once never suspends. If it would block, await_ready returns with the
+    // channel still locked and await_suspend parks the coroutine before
+    // unlocking; nothing can complete it in between.
+
+    // ---- co_await ch.send(value) -> bool ----
+    class SendAwaiter {
+    public:
+        SendAwaiter(Channel& ch, T value) : ch_(ch), value_(std::move(value)) {}
+
+        bool await_ready() {
+            std::unique_lock lock(ch_.mutex_);
+            const Outcome out = ch_.try_send_locked(value_);
+            if (out.status == detail::ChannelStatus::WouldBlock) {
+                lock.release(); // Unlocked by await_suspend
+                return false;
+            }
+            waiter_.ok = out.status == detail::ChannelStatus::Done;
+            lock.unlock();
+            return detail::hand_off(ch_.executor_, out.partner, transfer_to_);
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> self) {
+            if (transfer_to_)
+                return ch_.transfer(self, transfer_to_);
+            waiter_.handle = self;
+            waiter_.value = &value_;
+            ch_.senders_.push_back(&waiter_);
+            ch_.mutex_.unlock(); // From here on *this may already be gone
+            return std::noop_coroutine();
+        }
+
+        bool await_resume() const noexcept { return waiter_.ok; }
+
+    private:
+        Channel& ch_;
+        T value_;
+        SendWaiter waiter_;
+        std::coroutine_handle<> transfer_to_;
+    };
+
+    // ---- co_await ch.receive() -> std::optional<T> ----
+    class ReceiveAwaiter {
+    public:
+        explicit ReceiveAwaiter(Channel& ch) : ch_(ch) {}
+
+        bool await_ready() {
+            std::unique_lock lock(ch_.mutex_);
+            const Outcome out = ch_.try_receive_locked(result_);
+            if (out.status == detail::ChannelStatus::WouldBlock) {
+                lock.release();
+                return false;
+            }
+            lock.unlock();
+            return detail::hand_off(ch_.executor_, out.partner, transfer_to_);
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> self) {
+            if (transfer_to_)
+                return ch_.transfer(self, transfer_to_);
+            waiter_.handle = self;
+            waiter_.slot = &result_;
+            ch_.receivers_.push_back(&waiter_);
+            ch_.mutex_.unlock();
+            return std::noop_coroutine();
+        }
+
+        std::optional<T> await_resume() noexcept { return std::move(result_); }
+
+    private:
+        Channel& ch_;
+        std::optional<T> result_;
+        ReceiveWaiter waiter_;
+        std::coroutine_handle<> transfer_to_;
+    };
+
+    // ---- select cases ----
+    class ReceiveCase {
+    public:
+        using result_type = std::optional<T>; // nullopt: channel closed
+
+        explicit ReceiveCase(Channel& ch) : ch_(&ch) {}
+
+        std::mutex& mutex() const noexcept { return ch_->mutex_; }
+        Outcome try_locked() { return ch_->try_receive_locked(result_); }
+        void park_locked(std::coroutine_handle<> h, std::atomic<bool>* done) {
+            waiter_.handle = h;
+            waiter_.select_done = done;
+            waiter_.slot = &result_;
+            ch_->receivers_.push_back(&waiter_);
+        }
+        // Returns true if this case is the one that fired
+        bool unpark_locked() noexcept {
+            if (waiter_.linked)
+                ch_->receivers_.unlink(&waiter_);
+            return waiter_.fired;
+        }
+        ThreadPool* executor() const noexcept { return ch_->executor_; }
+        result_type take() noexcept { return std::move(result_); }
+
+    private:
+        Channel* ch_;
+        std::optional<T> result_;
+        ReceiveWaiter waiter_;
+    };
+
+    class SendCase {
+    public:
+        using result_type = bool; // false: channel closed
+
+        SendCase(Channel& ch, T value) : ch_(&ch), value_(std::move(value)) {}
+
+        std::mutex& mutex() const noexcept { return ch_->mutex_; }
+        Outcome try_locked() {
+            Outcome out = ch_->try_send_locked(value_);
+            waiter_.ok = out.status == detail::ChannelStatus::Done;
+            return out;
+        }
+        void park_locked(std::coroutine_handle<> h, std::atomic<bool>* done) {
+            waiter_.handle = h;
+            waiter_.select_done = done;
+            waiter_.value = &value_;
+            ch_->senders_.push_back(&waiter_);
+        }
+        bool unpark_locked() noexcept {
+            if (waiter_.linked)
+                ch_->senders_.unlink(&waiter_);
+            return waiter_.fired;
+        }
+        ThreadPool* executor() const noexcept { return ch_->executor_; }
+        result_type take() const noexcept { return waiter_.ok; }
+
+    private:
+        Channel* ch_;
+        T value_;
+        SendWaiter waiter_;
+    };
+
+    [[nodiscard]] SendAwaiter send(T value) { return SendAwaiter{*this, std::move(value)}; }
+    [[nodiscard]] ReceiveAwaiter receive() { return ReceiveAwaiter{*this}; }
+    [[nodiscard]] SendCase send_case(T value) { return SendCase{*this, std::move(value)}; }
+    [[nodiscard]] ReceiveCase receive_case() { return ReceiveCase{*this}; }
+
+    // No further sends succeed. Receivers drain the buffer, then get nullopt;
+    // every parked sender and receiver is resumed now.
+    void close() {
+        std::vector<std::coroutine_handle<>> wake;
+        {
+            std::lock_guard lock(mutex_);
+            if (closed_)
+                return;
+            closed_ = true;
+            for (auto* list : {&receivers_, &senders_}) {
+                while (detail::ChannelWaiter* w = list->pop_claimed()) {
+                    w->fired = true;
+                    w->ok = false;
+                    wake.push_back(w->handle);
+                }
+            }
+        }
+        for (auto h : wake)
+            resume(h);
+    }
+
+    bool closed() const {
+        std::lock_guard lock(mutex_);
+        return closed_;
+    }
+
+    std::size_t size() const {
+        std::lock_guard lock(mutex_);
+        return buffer_.size();
+    }
+
+    std::size_t capacity() const noexcept { return capacity_; }
+
+private:
+    Outcome try_send_locked(T& value) {
+        if (closed_)
+            return {detail::ChannelStatus::Closed};
+        if (auto* r = static_cast<ReceiveWaiter*>(receivers_.pop_claimed())) {
+            r->slot->emplace(std::move(value));
+            r->fired = r->ok = true;
+            return {detail::ChannelStatus::Done, r->handle};
+        }
+        if (buffer_.size() < capacity_) {
+            buffer_.push_back(std::move(value));
+            return {detail::ChannelStatus::Done};
+        }
+        return {detail::ChannelStatus::WouldBlock};
+    }
+
+    Outcome try_receive_locked(std::optional<T>& out) {
+        if (!buffer_.empty()) {
+            out.emplace(std::move(buffer_.front()));
+            buffer_.pop_front();
+            // A slot opened up: let the oldest blocked sender in
+            if (auto* s = static_cast<SendWaiter*>(senders_.pop_claimed())) {
+                buffer_.push_back(std::move(*s->value));
+                s->fired = s->ok = true;
+                return {detail::ChannelStatus::Done, s->handle};
+            }
+            return {detail::ChannelStatus::Done};
+        }
+        if (auto* s = static_cast<SendWaiter*>(senders_.pop_claimed())) {
+            out.emplace(std::move(*s->value)); // Rendezvous
+            s->fired = s->ok = true;
+            return {detail::ChannelStatus::Done, s->handle};
+        }
+        if (closed_)
+            return {detail::ChannelStatus::Closed};
+        return {detail::ChannelStatus::WouldBlock};
+    }
+
+    // Takes partner by value: once self is posted, its awaiter may be gone
+    std::coroutine_handle<> transfer(std::coroutine_handle<> self, std::coroutine_handle<> partner) {
+        executor_->post(self);
+        return partner;
+    }
+
+    void resume(std::coroutine_handle<> h) {
+        if (executor_)
+            executor_->post(h);
+        else
+            detail::resume_inline(h);
+    }
+
+    mutable std::mutex mutex_;
+    std::deque<T> buffer_;
+    std::size_t capacity_;
+    bool closed_ = false;
+    detail::WaiterList senders_;
+    detail::WaiterList receivers_;
+    ThreadPool* executor_;
+};
+
+// ============================================================================
+// select - wait for the first of several channel operations
+// ============================================================================
+// co_await select(cases...) yields std::variant<result_type...>; index() is
+// the case that completed (receive: optional<T>, send: bool). Exactly one
+// case takes effect. Cases that can complete right away are tried in
+// argument order. As in Go's selectgo, every involved channel is locked
+// (in address order) while polling and parking, so no case can fire before
+// all of them are parked.
+
+template <typename... Cases>
+class SelectAwaiter {
+    static constexpr std::size_t N = sizeof...(Cases);
+
+public:
+    using result_type = std::variant<typename Cases::result_type...>;
+
+    explicit SelectAwaiter(Cases... cases) : cases_(std::move(cases)...) {}
+
+    // Same split as the plain awaiters: poll in await_ready, and if nothing
+    // can complete, keep every channel locked until all cases are parked
+    bool await_ready() {
+        locks_ = mutexes();
+        for (std::mutex* m : locks_)
+            if (m) m->lock();
+
+        std::coroutine_handle<> partner = nullptr;
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            (void)((try_case<Is>(partner)) || ...);
+        }(std::index_sequence_for<Cases...>{});
+        if (fired_ == N)
+            return false;
+
+        unlock(locks_);
+        return detail::hand_off(executor_, partner, transfer_to_);
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> self) {
+        if (const auto partner = transfer_to_) {
+            executor_->post(self); // self may resume elsewhere before this returns
+            return partner;
+        }
+        std::apply([&](auto&... c) { (c.park_locked(self, &done_), ...); }, cases_);
+        // Once the first channel is unlocked a parked case may fire and this
+        // awaiter may be destroyed, so unlock from a local copy
+        unlock(std::array<std::mutex*, N>(locks_));
+        return std::noop_coroutine();
+    }
+
+    result_type await_resume() {
+        // Locking each channel also makes the firing thread's writes visible
+        std::optional<result_type> result;
+        if (fired_ < N)
+            result = take<0>(fired_);
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            (
+                [&] {
+                    auto& c = std::get<Is>(cases_);
+                    std::lock_guard lock(c.mutex());
+                    if (c.unpark_locked() && !result)
+                        result.emplace(std::in_place_index<Is>, c.take());
+                }(),
+                ...);
+        }(std::index_sequence_for<Cases...>{});
+        return std::move(*result);
+    }
+
+private:
+    template <std::size_t I>
+    bool try_case(std::coroutine_handle<>& partner) {
+        auto& c = std::get<I>(cases_);
+        auto out = c.try_locked();
+        if (out.status == detail::ChannelStatus::WouldBlock)
+            return false;
+        fired_ = I;
+        partner = out.partner;
+        executor_ = c.executor();
+        return true;
+    }
+
+    static void unlock(const std::array<std::mutex*, N>& locks) noexcept {
+        for (std::mutex* m : locks)
+            if (m) m->unlock();
+    }
+
+    template <std::size_t I>
+    std::optional<result_type> take(std::size_t index) {
+        if constexpr (I == N) {
+            return std::nullopt;
+        } else {
+            if (index == I)
+                return result_type(std::in_place_index<I>, std::get<I>(cases_).take());
+            return take<I + 1>(index);
+        }
+    }
+
+    // Sorted, so two selects never lock in opposite orders; a channel named
+    // by two cases is locked once (duplicates become nullptr)
+    std::array<std::mutex*, N> mutexes() const {
+        std::array<std::mutex*, N> ms{};
+        std::size_t i = 0;
+        std::apply([&](const auto&... c) { ((ms[i++] = &c.mutex()), ...); }, cases_);
+        std::sort(ms.begin(), ms.end(), std::less<std::mutex*>{});
+        std::fill(std::unique(ms.begin(), ms.end()), ms.end(), nullptr);
+        return ms;
+    }
+
+    std::tuple<Cases...> cases_;
+    std::atomic<bool> done_{false};
+    std::size_t fired_ = N; // Set when a case completes without parking
+    std::array<std::mutex*, N> locks_{};
+    ThreadPool* executor_ = nullptr;
+    std::coroutine_handle<> transfer_to_;
+};
+
+template <typename... Cases>
+SelectAwaiter<Cases...> select(Cases... cases) {
+    static_assert(sizeof...(Cases) > 0, "select needs at least one case");
+    return SelectAwaiter<Cases...>{std::move(cases)...};
+}
+
+} // namespace coro
@@ -1,15 +1,37 @@
 #include "CoroutinesSample.hpp"
+#include "AsyncTask.hpp"
+#include "StructuredConcurrency.hpp"
+#include "Channel.hpp"
+#include "AsyncSync.hpp"
+#include "IoReactor.hpp"
 #include <iostream>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
 #include <coroutine>
 #include <exception>
+#include <numeric>
 #include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <string>
 #include <thread>
 #include <chrono>
+#include <cstdint>
+#include <filesystem>
 #include <functional>
+#include <memory>
 #include <queue>
 
+#ifdef CORO_HAS_ASYNC_FILE_IO
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 // Use anonymous namespace to ensure internal linkage and avoid ODR violations
 namespace {
 
@@ -92,7 +114,11 @@ public:
             return *this;
         }
 
-        T& operator*() { return handle_.promise().current_value; }
+        // Post-increment and a const dereference make this a std::input_iterator,
+        // so Generator<T> plugs straight into std::ranges::views
+        void operator++(int) { ++*this; }
+
+        T& operator*() const { return handle_.promise().current_value; }
         
         bool operator==(const iterator& other) const {
             return handle_ == other.handle_;
@@ -379,6 +405,565 @@ private:
     handle_type handle_;
 };
 
+// ============================================================================
+// Part 5: ChunkedGenerator - Buffered Multi-Yield for Small Element Types
+// ============================================================================
+// Generator<T> suspends on every co_yield, so each element costs a full
+// resume/suspend round trip. For tiny T (ints, floats) that round trip
+// dwarfs the work. ChunkedGenerator keeps the same co_yield-per-element body
+// but only suspends when its internal buffer is full: yield_value() returns
+// an awaiter whose await_ready() is true until the chunk fills up, so one
+// resume produces up to ChunkSize elements.
+
+template <typename T, std::size_t ChunkSize = 256>
+    requires std::default_initializable<T> && (ChunkSize > 0)
+class ChunkedGenerator {
+public:
+    struct promise_type {
+        std::array<T, ChunkSize> buffer{};
+        std::size_t count = 0;
+
+        ChunkedGenerator get_return_object() {
+            return ChunkedGenerator{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        // Only a full buffer actually suspends the coroutine
+        struct YieldAwaiter {
+            bool buffer_has_room;
+            bool await_ready() const noexcept { return buffer_has_room; }
+            void await_suspend(std::coroutine_handle<>) const noexcept {}
+            void await_resume() const noexcept {}
+        };
+
+        YieldAwaiter yield_value(T value) noexcept(std::is_nothrow_move_assignable_v<T>) {
+            buffer[count++] = std::move(value);
+            return YieldAwaiter{count < ChunkSize};
+        }
+
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    explicit ChunkedGenerator(handle_type h) : handle_(h) {}
+
+    ChunkedGenerator(const ChunkedGenerator&) = delete;
+    ChunkedGenerator& operator=(const ChunkedGenerator&) = delete;
+
+    ChunkedGenerator(ChunkedGenerator&& other) noexcept : handle_(other.handle_) {
+        other.handle_ = nullptr;
+    }
+
+    ChunkedGenerator& operator=(ChunkedGenerator&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = other.handle_;
+            other.handle_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~ChunkedGenerator() {
+        if (handle_) handle_.destroy();
+    }
+
+    // Refill the buffer with one resume. Returns the new chunk, which is
+    // empty once the coroutine has finished and nothing is left.
+    std::span<const T> next_chunk() {
+        if (!handle_ || handle_.done()) return {};
+        auto& promise = handle_.promise();
+        promise.count = 0;
+        handle_.resume();
+        return {promise.buffer.data(), promise.count};
+    }
+
+    // Range of chunks: each element is a contiguous std::span<const T> that
+    // consumers can hand to vectorizable algorithms.
+    class chunk_iterator {
+    public:
+        using value_type = std::span<const T>;
+        using difference_type = std::ptrdiff_t;
+
+        chunk_iterator() = default;
+        explicit chunk_iterator(ChunkedGenerator* gen) : gen_(gen), chunk_(gen->next_chunk()) {}
+
+        std::span<const T> operator*() const { return chunk_; }
+
+        chunk_iterator& operator++() {
+            chunk_ = gen_->next_chunk();
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const chunk_iterator& it, std::default_sentinel_t) {
+            return it.chunk_.empty();
+        }
+
+    private:
+        ChunkedGenerator* gen_ = nullptr;
+        std::span<const T> chunk_;
+    };
+
+    struct chunk_range {
+        ChunkedGenerator* gen;
+        chunk_iterator begin() const { return chunk_iterator{gen}; }
+        std::default_sentinel_t end() const { return {}; }
+    };
+
+    chunk_range chunks() { return chunk_range{this}; }
+
+    // Element-wise iteration walks the buffer and only resumes per chunk
+    class iterator {
+    public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(ChunkedGenerator* gen) : gen_(gen), chunk_(gen->next_chunk()) {}
+
+        const T& operator*() const { return chunk_[index_]; }
+
+        iterator& operator++() {
+            if (++index_ == chunk_.size()) {
+                chunk_ = gen_->next_chunk();
+                index_ = 0;
+            }
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t) {
+            return it.chunk_.empty();
+        }
+
+    private:
+        ChunkedGenerator* gen_ = nullptr;
+        std::span<const T> chunk_;
+        std::size_t index_ = 0;
+    };
+
+    iterator begin() { return iterator{this}; }
+    std::default_sentinel_t end() { return {}; }
+
+private:
+    handle_type handle_;
+};
+
+// Size-specialized alias: small trivially copyable elements get the chunked
+// mode automatically, everything else keeps one resume per element.
+template <typename T>
+using AutoGenerator = std::conditional_t<
+    (sizeof(T) <= 16 && std::is_trivially_copyable_v<T>),
+    ChunkedGenerator<T>, Generator<T>>;
+
+// Same body as range(), only the return type changes
+ChunkedGenerator<int> chunked_range(int start, int end) {
+    for (int i = start; i < end; ++i) {
+        co_yield i;
+    }
+}
+
+AutoGenerator<int> auto_fibonacci(int count) {
+    int a = 0, b = 1;
+    for (int i = 0; i < count; ++i) {
+        co_yield a;
+        int next = a + b;
+        a = b;
+        b = next;
+    }
+}
+
+// ============================================================================
+// Part 6: Generator Pipelines - Fused Range Adaptors
+// ============================================================================
+// Chaining generators naively (a generator that loops over another generator)
+// costs one heap frame and one resume per stage per element. Because
+// Generator<T> is an input_range, the combinators below are plain range
+// adaptors over its iterator instead: the whole pipeline is one iterator
+// stack, the only coroutine frame is the source, and each element costs a
+// single resume plus inlined function calls. They compose freely with
+// std::ranges::views.
+
+// gen | gmap(f) | gfilter(p) | gtake(n)
+constexpr auto gmap = [](auto f) { return std::views::transform(std::move(f)); };
+constexpr auto gfilter = [](auto pred) { return std::views::filter(std::move(pred)); };
+constexpr auto gtake = [](std::ptrdiff_t n) { return std::views::take(n); };
+
+// Pairwise zip of two input ranges; stops at the shorter one. Works with
+// single-pass sources like generators, which only need ++ and *.
+template <std::ranges::input_range V1, std::ranges::input_range V2>
+    requires std::ranges::view<V1> && std::ranges::view<V2>
+class ZipPairView : public std::ranges::view_interface<ZipPairView<V1, V2>> {
+public:
+    ZipPairView() = default;
+    ZipPairView(V1 first, V2 second) : first_(std::move(first)), second_(std::move(second)) {}
+
+    class iterator {
+    public:
+        using value_type = std::pair<std::ranges::range_value_t<V1>, std::ranges::range_value_t<V2>>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        iterator(ZipPairView* parent)
+            : parent_(parent),
+              it1_(std::ranges::begin(parent->first_)),
+              it2_(std::ranges::begin(parent->second_)) {}
+
+        std::pair<std::ranges::range_reference_t<V1>, std::ranges::range_reference_t<V2>>
+        operator*() const { return {*it1_, *it2_}; }
+
+        iterator& operator++() {
+            ++it1_;
+            ++it2_;
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t) {
+            return it.at_end();
+        }
+
+    private:
+        bool at_end() const {
+            return it1_ == std::ranges::end(parent_->first_) ||
+                   it2_ == std::ranges::end(parent_->second_);
+        }
+
+        ZipPairView* parent_ = nullptr;
+        std::ranges::iterator_t<V1> it1_;
+        std::ranges::iterator_t<V2> it2_;
+    };
+
+    iterator begin() { return iterator{this}; }
+    std::default_sentinel_t end() { return {}; }
+
+private:
+    V1 first_;
+    V2 second_;
+};
+
+template <typename R1, typename R2>
+ZipPairView(R1&&, R2&&) -> ZipPairView<std::views::all_t<R1>, std::views::all_t<R2>>;
+
+template <typename V2>
+struct GZipClosure {
+    V2 other;
+
+    template <std::ranges::viewable_range R1>
+    friend auto operator|(R1&& lhs, GZipClosure closure) {
+        return ZipPairView(std::views::all(std::forward<R1>(lhs)), std::move(closure.other));
+    }
+};
+
+// gen | gzip(other_gen)
+constexpr auto gzip = []<std::ranges::viewable_range R>(R&& other) {
+    return GZipClosure<std::views::all_t<R>>{std::views::all(std::forward<R>(other))};
+};
+
+// The naive alternative: each stage is its own coroutine frame
+template <typename F>
+Generator<int> nested_map(Generator<int> source, F f) {
+    for (int v : source) co_yield f(v);
+}
+
+template <typename P>
+Generator<int> nested_filter(Generator<int> source, P pred) {
+    for (int v : source) {
+        if (pred(v)) co_yield v;
+    }
+}
+
+Generator<int> nested_take(Generator<int> source, int n) {
+    if (n <= 0) co_return;
+    for (int v : source) {
+        co_yield v;
+        if (--n == 0) co_return;
+    }
+}
+
+// ============================================================================
+// Part 7: Structured Concurrency with coro::Task
+// ============================================================================
+// The Task above is eager and get() only reads the promise. coro::Task (see
+// AsyncTask.hpp) is lazy and awaitable, carries a std::stop_token, and the
+// combinators in StructuredConcurrency.hpp fan work out and guarantee every
+// child has finished before the parent continues.
+
+using namespace std::chrono_literals;
+
+// A sub-request with a simulated backend latency
+coro::Task<int> fetch_shard(coro::ThreadPool& pool, int shard, std::chrono::milliseconds latency) {
+    co_await pool.schedule();
+    co_await coro::sleep_for(latency);
+    co_return shard;
+}
+
+coro::Task<int> query_replica(int replica, std::chrono::milliseconds latency, std::atomic<int>& cancelled) {
+    try {
+        co_await coro::sleep_for(latency);
+    } catch (const coro::operation_cancelled&) {
+        cancelled.fetch_add(1);
+        throw;
+    }
+    co_return replica;
+}
+
+coro::Task<long long> fan_out_all(coro::ThreadPool& pool, int count) {
+    std::vector<coro::Task<int>> requests;
+    for (int i = 0; i < count; ++i) {
+        requests.push_back(fetch_shard(pool, i, std::chrono::milliseconds{1 + i % 20}));
+    }
+    auto results = co_await coro::when_all(std::move(requests));
+    co_return std::accumulate(results.begin(), results.end(), 0LL);
+}
+
+coro::Task<int> fan_out_with_budget(coro::ThreadPool& pool, int count, std::chrono::milliseconds budget) {
+    std::vector<coro::Task<std::optional<int>>> requests;
+    for (int i = 0; i < count; ++i) {
+        requests.push_back(coro::with_timeout(fetch_shard(pool, i, std::chrono::milliseconds{1 + i % 40}), budget));
+    }
+    auto results = co_await coro::when_all(std::move(requests));
+    co_return static_cast<int>(std::count_if(results.begin(), results.end(),
+                                             [](const auto& r) { return r.has_value(); }));
+}
+
+coro::Task<void> worker_child(std::chrono::milliseconds latency, bool fail, std::atomic<int>& finished) {
+    struct CountOnExit {
+        std::atomic<int>& finished;
+        ~CountOnExit() { finished.fetch_add(1); }
+    } guard{finished};
+    co_await coro::sleep_for(latency);
+    if (fail) throw std::runtime_error("child failed");
+}
+
+coro::Task<void> long_poll() {
+    co_await coro::sleep_for(10s);
+}
+
+#ifdef CORO_HAS_ASYNC_FILE_IO
+
+// ============================================================================
+// Part 8: Awaitable File I/O
+// ============================================================================
+// open/close stay synchronous (cheap metadata calls) and are done for a whole
+// wave up front; the transfers are awaited, so the wave's reads or writes are
+// all queued at once and the reactor can submit them in a few batches.
+
+constexpr std::size_t kIoFileSize = 4096;
+
+std::byte file_byte(std::size_t file, std::size_t i) {
+    return static_cast<std::byte>((file * 31 + i * 7) & 0xff);
+}
+
+// Returns the number of bytes that did not make it to disk
+coro::Task<std::size_t> write_file(coro::IoReactor& io, int fd, std::size_t file) {
+    std::vector<std::byte> data(kIoFileSize);
+    for (std::size_t i = 0; i < data.size(); ++i) data[i] = file_byte(file, i);
+    co_return kIoFileSize - co_await io.write(fd, data, 0);
+}
+
+// Returns the number of bytes that differ from what write_file stored
+coro::Task<std::size_t> verify_file(coro::IoReactor& io, int fd, std::size_t file) {
+    std::vector<std::byte> data(kIoFileSize);
+    const std::size_t got = co_await io.read(fd, data, 0);
+    std::size_t mismatches = kIoFileSize - got;
+    for (std::size_t i = 0; i < got; ++i) {
+        if (data[i] != file_byte(file, i)) ++mismatches;
+    }
+    co_return mismatches;
+}
+
+struct FileIoRun {
+    std::size_t mismatches = 0;
+    coro::IoReactor::Stats stats;
+    std::chrono::microseconds transfer_time{0};  // Excludes open/close
+};
+
+// Creates `files` files under `dir` and reads them back, in waves of `wave`
+// concurrent operations. Fresh files keep ext4's truncate-then-rewrite flush
+// out of the measurement.
+FileIoRun round_trip_files(coro::IoReactor& io, const std::filesystem::path& dir, std::size_t files,
+                           std::size_t wave) {
+    std::filesystem::create_directories(dir);
+    FileIoRun run;
+    for (bool writing : {true, false}) {
+        for (std::size_t first = 0; first < files; first += wave) {
+            const std::size_t last = std::min(files, first + wave);
+            std::vector<int> fds;
+            for (std::size_t i = first; i < last; ++i) {
+                const auto path = dir / ("f" + std::to_string(i) + ".bin");
+                const int fd = writing ? ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644)
+                                       : ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+                if (fd < 0) {
+                    for (int opened : fds) ::close(opened);
+                    throw std::system_error(errno, std::generic_category(), "open");
+                }
+                fds.push_back(fd);
+            }
+            std::vector<coro::Task<std::size_t>> transfers;
+            for (std::size_t i = first; i < last; ++i) {
+                transfers.push_back(writing ? write_file(io, fds[i - first], i) : verify_file(io, fds[i - first], i));
+            }
+            const auto start = std::chrono::steady_clock::now();
+            auto results = coro::sync_wait(coro::when_all(std::move(transfers)));
+            run.transfer_time += std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start);
+            for (int fd : fds) ::close(fd);
+            run.mismatches += std::accumulate(results.begin(), results.end(), std::size_t{0});
+        }
+    }
+    run.stats = io.stats();
+    return run;
+}
+
+const char* backend_name(coro::IoBackend backend) {
+    return backend == coro::IoBackend::IoUring ? "io_uring" : "thread pool (pread/pwrite)";
+}
+
+#endif // CORO_HAS_ASYNC_FILE_IO
+
+// ============================================================================
+// Part 9: Channels
+// ============================================================================
+// A BoundedQueue stage owns a thread that sleeps in pop(). A Channel stage is
+// a coroutine that suspends in receive(), so a pipeline's depth is no longer
+// bounded by how many threads the process can afford.
+
+coro::Task<void> pipeline_source(coro::Channel<int>& out, int items) {
+    for (int i = 0; i < items; ++i) {
+        co_await out.send(i);
+    }
+    out.close();
+}
+
+coro::Task<void> pipeline_stage(coro::Channel<int>& in, coro::Channel<int>& out) {
+    while (auto value = co_await in.receive()) {
+        co_await out.send(*value + 1);
+    }
+    out.close(); // Propagate the shutdown downstream
+}
+
+coro::Task<void> pipeline_sink(coro::Channel<int>& in, long long& sum) {
+    while (auto value = co_await in.receive()) {
+        sum += *value;
+    }
+}
+
+coro::Task<long long> run_pipeline(coro::ThreadPool& pool, std::size_t stages, int items, std::size_t capacity) {
+    std::vector<std::unique_ptr<coro::Channel<int>>> channels;
+    for (std::size_t i = 0; i <= stages; ++i) {
+        channels.push_back(std::make_unique<coro::Channel<int>>(capacity, &pool));
+    }
+    long long sum = 0;
+    co_await coro::task_scope([&](coro::TaskGroup& group) -> coro::Task<void> {
+        for (std::size_t i = 0; i < stages; ++i) {
+            group.spawn(pipeline_stage(*channels[i], *channels[i + 1]));
+        }
+        group.spawn(pipeline_sink(*channels.back(), sum));
+        group.spawn(pipeline_source(*channels.front(), items));
+        co_return;
+    });
+    co_return sum;
+}
+
+// Go's "for { select { case jobs <- i: case <-quit: return } }"
+coro::Task<void> job_producer(coro::Channel<int>& jobs, coro::Channel<int>& quit, int& produced) {
+    for (int i = 0;; ++i) {
+        auto fired = co_await coro::select(jobs.send_case(i), quit.receive_case());
+        if (fired.index() == 1 || !std::get<0>(fired)) break;
+        ++produced;
+    }
+    jobs.close();
+}
+
+coro::Task<void> job_consumer(coro::Channel<int>& jobs, coro::Channel<int>& quit, int wanted, int& consumed) {
+    while (consumed < wanted) {
+        auto job = co_await jobs.receive();
+        if (!job) break;
+        ++consumed;
+    }
+    quit.close(); // Closing is a broadcast: every select on quit fires
+}
+
+// Fan-in: whichever producer has a value ready is served first
+coro::Task<void> merge_two(coro::Channel<int>& a, coro::Channel<int>& b, std::array<int, 2>& received) {
+    bool a_open = true;
+    bool b_open = true;
+    while (a_open || b_open) {
+        std::size_t from = 0;
+        bool got = false;
+        if (a_open && b_open) {
+            auto fired = co_await coro::select(a.receive_case(), b.receive_case());
+            from = fired.index();
+            got = from == 0 ? std::get<0>(fired).has_value() : std::get<1>(fired).has_value();
+        } else {
+            from = a_open ? 0 : 1;
+            got = (co_await (a_open ? a : b).receive()).has_value();
+        }
+        if (got) {
+            ++received[from];
+        } else {
+            (from == 0 ? a_open : b_open) = false;
+        }
+    }
+}
+
+// ============================================================================
+// Part 10: Async Mutex, Semaphore and Latch
+// ============================================================================
+// BankAccount in ThreadSafetySample guards its balance with a std::mutex,
+// which cannot be held across a co_await. CoroAccount holds an AsyncMutex
+// while it awaits an audit write, and a concurrency-limited client uses an
+// AsyncSemaphore to cap requests in flight.
+
+class CoroAccount {
+public:
+    explicit CoroAccount(coro::ThreadPool& pool) : mutex_(pool) {}
+
+    coro::Task<void> deposit(int amount) {
+        auto lock = co_await mutex_.lock();
+        const int before = balance_;
+        co_await coro::sleep_for(50us); // Audit write while holding the lock
+        balance_ = before + amount;
+    }
+
+    coro::Task<int> balance() {
+        auto lock = co_await mutex_.lock();
+        co_return balance_;
+    }
+
+private:
+    coro::AsyncMutex mutex_;
+    int balance_ = 0;
+};
+
+struct ClientStats {
+    std::atomic<int> in_flight{0};
+    std::atomic<int> peak{0};
+};
+
+coro::Task<void> limited_request(coro::AsyncSemaphore& limit, ClientStats& stats, coro::AsyncLatch& done) {
+    {
+        auto permit = co_await limit.scoped_acquire();
+        const int now = stats.in_flight.fetch_add(1) + 1;
+        int peak = stats.peak.load();
+        while (now > peak && !stats.peak.compare_exchange_weak(peak, now)) {
+        }
+        co_await coro::sleep_for(2ms);
+        stats.in_flight.fetch_sub(1);
+    }
+    done.count_down();
+}
+
+coro::Task<void> gated_worker(coro::AsyncEvent& start, std::atomic<int>& started) {
+    co_await start.wait();
+    started.fetch_add(1);
+}
+
 // ============================================================================
 // Demonstration Functions
 // ============================================================================
@@ -419,6 +1004,119 @@ void demonstrate_generators() {
     std::cout << "(stopped early)" << std::endl;
 }
 
+void demonstrate_chunked_generators() {
+    std::cout << "\n=== Chunked Generators ===" << std::endl;
+
+    std::cout << "chunked_range(0, 10): ";
+    for (int i : chunked_range(0, 10)) {
+        std::cout << i << " ";
+    }
+    std::cout << std::endl;
+
+    std::cout << "AutoGenerator<int> picks the chunked mode for fibonacci: ";
+    for (int f : auto_fibonacci(10)) {
+        std::cout << f << " ";
+    }
+    std::cout << std::endl;
+
+    // Chunks are plain contiguous spans
+    auto gen = chunked_range(0, 600);
+    std::cout << "Chunk sizes for 600 elements: ";
+    for (std::span<const int> chunk : gen.chunks()) {
+        static_assert(std::ranges::contiguous_range<decltype(chunk)>);
+        std::cout << chunk.size() << " ";
+    }
+    std::cout << std::endl;
+
+    // Benchmark: one resume per element vs one resume per 256 elements.
+    // Kept at 1e7 so the sample stays quick; the ratio holds for 1e9.
+    constexpr int kCount = 10'000'000;
+    using clock = std::chrono::steady_clock;
+
+    auto start = clock::now();
+    long long element_sum = 0;
+    for (int i : range(0, kCount)) {
+        element_sum += i;
+    }
+    auto element_time = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start);
+
+    start = clock::now();
+    long long chunked_sum = 0;
+    auto chunked = chunked_range(0, kCount);
+    for (std::span<const int> chunk : chunked.chunks()) {
+        chunked_sum = std::reduce(chunk.begin(), chunk.end(), chunked_sum,
+                                  [](long long acc, int v) { return acc + v; });
+    }
+    auto chunked_time = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start);
+
+    std::cout << "\nrange(0, " << kCount << ") summed:" << std::endl;
+    std::cout << "  element-at-a-time: " << element_time.count() << " us (sum " << element_sum << ")" << std::endl;
+    std::cout << "  chunked (256):     " << chunked_time.count() << " us (sum " << chunked_sum << ")" << std::endl;
+    if (chunked_time.count() > 0) {
+        std::cout << "  speedup: " << static_cast<double>(element_time.count()) /
+                                          static_cast<double>(chunked_time.count())
+                  << "x" << std::endl;
+    }
+}
+
+void demonstrate_generator_pipelines() {
+    std::cout << "\n=== Generator Pipelines ===" << std::endl;
+
+    static_assert(std::ranges::input_range<Generator<int>>);
+
+    std::cout << "range(0, 20) | gmap(x*x) | gfilter(odd) | gtake(4): ";
+    for (int v : range(0, 20) | gmap([](int x) { return x * x; })
+                              | gfilter([](int x) { return x % 2 == 1; })
+                              | gtake(4)) {
+        std::cout << v << " ";
+    }
+    std::cout << std::endl;
+
+    // Mixes with standard views
+    std::cout << "fibonacci(12) | std::views::drop(5) | gmap(x/2): ";
+    for (int v : fibonacci(12) | std::views::drop(5) | gmap([](int x) { return x / 2; })) {
+        std::cout << v << " ";
+    }
+    std::cout << std::endl;
+
+    std::cout << "split(\"a,b,c\") | gzip(range(1, 10)): ";
+    for (auto [word, index] : split("a,b,c", ',') | gzip(range(1, 10))) {
+        std::cout << index << "=" << word << " ";
+    }
+    std::cout << std::endl;
+
+    // Benchmark: 5-stage pipeline, fused adaptors vs one frame per stage
+    constexpr int kCount = 5'000'000;
+    constexpr int kTake = kCount / 10;
+    auto times3 = [](int x) { return x * 3; };
+    auto is_even = [](int x) { return x % 2 == 0; };
+    auto plus1 = [](int x) { return x + 1; };
+    auto not_mul5 = [](int x) { return x % 5 != 0; };
+    using clock = std::chrono::steady_clock;
+
+    auto start = clock::now();
+    long long fused_sum = 0;
+    for (int v : range(0, kCount) | gmap(times3) | gfilter(is_even) | gmap(plus1)
+                                  | gfilter(not_mul5) | gtake(kTake)) {
+        fused_sum += v;
+    }
+    auto fused_time = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start);
+
+    start = clock::now();
+    long long nested_sum = 0;
+    auto nested = nested_take(
+        nested_filter(nested_map(nested_filter(nested_map(range(0, kCount), times3), is_even), plus1), not_mul5),
+        kTake);
+    for (int v : nested) {
+        nested_sum += v;
+    }
+    auto nested_time = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start);
+
+    std::cout << "\n5-stage pipeline over range(0, " << kCount << "):" << std::endl;
+    std::cout << "  fused adaptors:    " << fused_time.count() << " us (sum " << fused_sum << ")" << std::endl;
+    std::cout << "  nested generators: " << nested_time.count() << " us (sum " << nested_sum << ")" << std::endl;
+}
+
 void demonstrate_tasks() {
     std::cout << "\n=== Task Coroutines ===" << std::endl;
     
@@ -437,6 +1135,216 @@ void demonstrate_awaitables() {
     std::cout << "Task completed" << std::endl;
 }
 
+void demonstrate_structured_concurrency() {
+    std::cout << "\n=== Structured Concurrency (coro::Task) ===" << std::endl;
+    using clock = std::chrono::steady_clock;
+    auto elapsed_ms = [](clock::time_point since) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - since).count();
+    };
+
+    coro::ThreadPool pool(2);
+
+    // when_all: 200 sub-requests at 1-20ms each finish in about the slowest one
+    auto start = clock::now();
+    long long sum = coro::sync_wait(fan_out_all(pool, 200));
+    std::cout << "when_all over 200 sub-requests: sum " << sum << " in "
+              << elapsed_ms(start) << " ms" << std::endl;
+
+    // when_any: hedged request, the fastest replica wins and the rest are cancelled
+    std::atomic<int> cancelled{0};
+    start = clock::now();
+    auto [winner, replica] = coro::sync_wait(coro::when_any(
+        query_replica(0, 40ms, cancelled), query_replica(1, 5ms, cancelled), query_replica(2, 60ms, cancelled)));
+    std::cout << "when_any over 3 replicas: replica " << replica << " (index " << winner << ") won in "
+              << elapsed_ms(start) << " ms, " << cancelled.load() << " losers cancelled" << std::endl;
+
+    // Latency budget: stragglers past 15ms are cut off instead of waited for
+    start = clock::now();
+    int answered = coro::sync_wait(fan_out_with_budget(pool, 100, 15ms));
+    std::cout << "100 sub-requests (1-40ms) with a 15ms budget: " << answered << " answered, "
+              << 100 - answered << " cut off, took " << elapsed_ms(start) << " ms" << std::endl;
+
+    // task_scope: a failing child cancels its siblings; all finish before the scope returns
+    std::atomic<int> finished{0};
+    try {
+        coro::sync_wait(coro::task_scope([&finished](coro::TaskGroup& group) -> coro::Task<void> {
+            group.spawn(worker_child(2ms, true, finished));
+            group.spawn(worker_child(1s, false, finished));
+            group.spawn(worker_child(1s, false, finished));
+            co_return;
+        }));
+    } catch (const std::exception& e) {
+        std::cout << "task_scope rethrew '" << e.what() << "' after " << finished.load()
+                  << " of 3 children finished" << std::endl;
+    }
+
+    // External cancellation through a std::stop_source
+    std::stop_source source;
+    std::jthread canceller([&source] {
+        std::this_thread::sleep_for(5ms);
+        source.request_stop();
+    });
+    start = clock::now();
+    try {
+        coro::sync_wait(long_poll(), source.get_token());
+    } catch (const coro::operation_cancelled&) {
+        std::cout << "10s long poll cancelled via stop_token after " << elapsed_ms(start) << " ms" << std::endl;
+    }
+}
+
+void demonstrate_channels() {
+    std::cout << "\n=== Channels (coro::Channel) ===" << std::endl;
+    using clock = std::chrono::steady_clock;
+    coro::ThreadPool pool(2);
+
+    // Every stage adds 1, so the sink sees items * (items - 1) / 2 + items * stages
+    for (std::size_t capacity : {std::size_t{0}, std::size_t{16}}) {
+        constexpr std::size_t stages = 2000;
+        constexpr int items = 200;
+        const auto start = clock::now();
+        const long long sum = coro::sync_wait(run_pipeline(pool, stages, items, capacity));
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count();
+        const long long expected = 1LL * items * (items - 1) / 2 + 1LL * items * static_cast<long long>(stages);
+        std::cout << stages << "-stage pipeline, capacity " << capacity << ", on 2 threads: " << items
+                  << " items, sum " << (sum == expected ? "ok" : "WRONG") << ", "
+                  << static_cast<double>(us) * 1000.0 / (static_cast<double>(stages) * items) << " ns per hop"
+                  << std::endl;
+    }
+    std::cout << "(with BoundedQueue each stage would be a thread: 2000 threads)" << std::endl;
+
+    // select over a send and a receive; closing quit stops the producer
+    coro::Channel<int> jobs(0, &pool);
+    coro::Channel<int> quit(0, &pool);
+    int produced = 0;
+    int consumed = 0;
+    coro::sync_wait(coro::task_scope([&](coro::TaskGroup& group) -> coro::Task<void> {
+        group.spawn(job_producer(jobs, quit, produced));
+        group.spawn(job_consumer(jobs, quit, 100, consumed));
+        co_return;
+    }));
+    std::cout << "select(send jobs, receive quit): consumer took " << consumed << ", producer sent " << produced
+              << " and stopped when quit was closed" << std::endl;
+
+    // select over two receives; each channel reports closed exactly once
+    coro::Channel<int> fast(4, &pool);
+    coro::Channel<int> slow(4, &pool);
+    std::array<int, 2> received{};
+    coro::sync_wait(coro::task_scope([&](coro::TaskGroup& group) -> coro::Task<void> {
+        group.spawn(merge_two(fast, slow, received));
+        group.spawn(pipeline_source(fast, 300));
+        group.spawn(pipeline_source(slow, 30));
+        co_return;
+    }));
+    std::cout << "select(receive a, receive b): merged " << received[0] << " + " << received[1]
+              << " values until both channels were closed" << std::endl;
+
+    // Same shutdown contract as BoundedQueue: queued items drain, new sends are refused
+    coro::Channel<int> closing(4);
+    auto drain = [&closing]() -> coro::Task<std::size_t> {
+        co_await closing.send(1);
+        co_await closing.send(2);
+        closing.close();
+        const bool accepted = co_await closing.send(3);
+        std::size_t drained = 0;
+        while (auto item = co_await closing.receive()) ++drained;
+        co_return accepted ? 0 : drained;
+    };
+    std::cout << "after close(): send refused, " << coro::sync_wait(drain()) << " queued items still received"
+              << std::endl;
+}
+
+void demonstrate_async_sync() {
+    std::cout << "\n=== Async Mutex, Semaphore and Latch ===" << std::endl;
+    using clock = std::chrono::steady_clock;
+    coro::ThreadPool pool(2);
+
+    // 4 x 25 deposits, each holding the lock across a co_await
+    CoroAccount account(pool);
+    coro::sync_wait(coro::task_scope([&](coro::TaskGroup& group) -> coro::Task<void> {
+        for (int client = 0; client < 4; ++client) {
+            group.spawn([](CoroAccount& acc) -> coro::Task<void> {
+                for (int i = 0; i < 25; ++i) co_await acc.deposit(10);
+            }(account));
+        }
+        co_return;
+    }));
+    std::cout << "AsyncMutex held across co_await: 100 deposits of 10, balance "
+              << coro::sync_wait(account.balance()) << std::endl;
+
+    // 64 requests of 2ms, at most 8 in flight: no faster than 64 / 8 * 2 = 16ms
+    constexpr int requests = 64;
+    coro::AsyncSemaphore limit(pool, 8);
+    coro::AsyncLatch done(pool, requests);
+    ClientStats stats;
+    const auto start = clock::now();
+    coro::sync_wait(coro::task_scope([&](coro::TaskGroup& group) -> coro::Task<void> {
+        for (int i = 0; i < requests; ++i) group.spawn(limited_request(limit, stats, done));
+        co_await done.wait();
+    }));
+    std::cout << "AsyncSemaphore(8): " << requests << " requests, peak " << stats.peak.load() << " in flight, took "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - start).count() << " ms"
+              << std::endl;
+
+    // Workers park on an event until it is set, then all resume on the pool
+    coro::AsyncEvent go(pool);
+    std::atomic<int> started{0};
+    coro::sync_wait(coro::task_scope([&](coro::TaskGroup& group) -> coro::Task<void> {
+        for (int i = 0; i < 10; ++i) group.spawn(gated_worker(go, started));
+        std::cout << "AsyncEvent: " << started.load() << " of 10 workers started before set()";
+        go.set();
+        co_return;
+    }));
+    std::cout << ", " << started.load() << " after" << std::endl;
+}
+
+#ifdef CORO_HAS_ASYNC_FILE_IO
+void demonstrate_file_io() {
+    std::cout << "\n=== Awaitable File I/O (coro::IoReactor) ===" << std::endl;
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / ("coro_io_demo_" + std::to_string(::getpid()));
+    fs::remove_all(dir);
+
+    constexpr std::size_t files = 2000;
+    constexpr std::size_t wave = 256;
+
+    {
+        // Registered buffer: pinned once when the reactor starts, reused by
+        // every fixed read
+        std::vector<std::byte> fixed(kIoFileSize);
+        const std::span<std::byte> buffers[] = {fixed};
+        coro::IoReactor io({.fixed_buffers = buffers});
+        auto run = round_trip_files(io, dir / "default", files, wave);
+        std::cout << backend_name(io.backend()) << ": " << files << " files written and read back ("
+                  << run.stats.operations << " ops, " << run.mismatches << " bad bytes), transfers "
+                  << std::chrono::duration<double, std::milli>(run.transfer_time).count() << " ms";
+        if (io.backend() == coro::IoBackend::IoUring) {
+            std::cout << ", " << run.stats.submit_calls << " io_uring_enter calls";
+        }
+        std::cout << std::endl;
+
+        if (io.backend() == coro::IoBackend::IoUring) {
+            const int fd = ::open((dir / "default" / "f7.bin").c_str(), O_RDONLY | O_CLOEXEC);
+            const auto got = coro::sync_wait([&io, fd]() -> coro::Task<std::size_t> {
+                co_return co_await io.read_fixed(fd, 0, kIoFileSize, 0);
+            }());
+            ::close(fd);
+            std::cout << "read_fixed into a registered buffer: " << got << " bytes, first byte "
+                      << (fixed[0] == file_byte(7, 0) ? "matches" : "differs") << std::endl;
+        }
+    }
+
+    {
+        coro::IoReactor io({.backend = coro::IoBackend::ThreadPool});
+        auto run = round_trip_files(io, dir / "thread_pool", files, wave);
+        std::cout << backend_name(io.backend()) << ": " << files << " files written and read back ("
+                  << run.stats.operations << " ops, " << run.mismatches << " bad bytes), transfers "
+                  << std::chrono::duration<double, std::milli>(run.transfer_time).count() << " ms" << std::endl;
+    }
+
+    fs::remove_all(dir);
+}
+#endif // CORO_HAS_ASYNC_FILE_IO
+
 void demonstrate_coroutine_concepts() {
     std::cout << "\n=== Coroutine Key Concepts ===" << std::endl;
     
@@ -514,8 +1422,16 @@ void CoroutinesSample::run() {
     std::cout << "They enable efficient async programming and lazy evaluation." << std::endl;
 
     demonstrate_generators();
+    demonstrate_chunked_generators();
+    demonstrate_generator_pipelines();
     demonstrate_tasks();
     demonstrate_awaitables();
+    demonstrate_structured_concurrency();
+    demonstrate_channels();
+    demonstrate_async_sync();
+#ifdef CORO_HAS_ASYNC_FILE_IO
+    demonstrate_file_io();
+#endif
     demonstrate_coroutine_concepts();
     demonstrate_use_cases();
     demonstrate_best_practices();
@@ -0,0 +1,567 @@
+#pragma once
+
+#include "AsyncTask.hpp"
+
+// Async file I/O needs POSIX pread/pwrite; io_uring additionally needs Linux.
+#if defined(__unix__) || defined(__APPLE__)
+#define CORO_HAS_ASYNC_FILE_IO 1
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define CORO_HAS_IO_URING 1
+#endif
+
+#ifdef CORO_HAS_ASYNC_FILE_IO
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#ifdef CORO_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace coro {
+
+// ============================================================================
+// IoReactor - awaitable file reads and writes
+// ============================================================================
+// co_await reactor.read(fd, buffer, offset) suspends the coroutine until the
+// kernel has filled the buffer, so a couple of threads can keep thousands of
+// file reads in flight. Two backends:
+//
+// - io_uring (Linux): submitters only queue the operation. The reactor
+//   thread turns everything queued since its last wake-up into SQEs and
+//   submits them with ONE io_uring_enter, which also waits for completions.
+//   Registered (fixed) buffers use READ_FIXED/WRITE_FIXED. Should
+//   io_uring_enter fail for good, the reactor thread carries on with
+//   blocking pread/pwrite, so no operation is left waiting.
+// - Thread pool: blocking pread/pwrite on a few worker threads. Used when
+//   io_uring is unavailable (old kernel, seccomp) or on other POSIX systems.
+//   epoll is not an option here: regular files are always "ready".
+//
+// Completed coroutines resume on the reactor/worker thread, or on a
+// ThreadPool when one is given in the options.
+
+enum class IoBackend { Auto, IoUring, ThreadPool };
+
+struct IoReactorOptions {
+    IoBackend backend = IoBackend::Auto;
+    unsigned queue_depth = 256;           // io_uring SQ entries
+    std::size_t fallback_threads = 2;     // Thread pool backend workers
+    ThreadPool* resume_on = nullptr;      // Optional executor for completions
+    // Pinned once, before the reactor thread starts, for read_fixed and
+    // write_fixed. Must outlive the reactor.
+    std::span<const std::span<std::byte>> fixed_buffers{};
+};
+
+class IoReactor;
+
+namespace detail {
+
+struct IoOperation {
+    enum class Kind { Read, Write, ReadFixed, WriteFixed };
+
+    Kind kind = Kind::Read;
+    int fd = -1;
+    void* data = nullptr;
+    unsigned length = 0;
+    std::uint64_t offset = 0;
+    unsigned buffer_index = 0;
+    int result = 0;  // Bytes transferred, or -errno
+    std::coroutine_handle<> handle;
+};
+
+} // namespace detail
+
+// Resumes with the number of bytes transferred (short reads at EOF are
+// normal); throws std::system_error on failure.
+class IoAwaiter {
+public:
+    IoAwaiter(IoReactor& reactor, detail::IoOperation op) noexcept : reactor_(reactor), op_(op) {}
+
+    bool await_ready() const noexcept { return op_.length == 0; }
+    void await_suspend(std::coroutine_handle<> h);
+
+    std::size_t await_resume() const {
+        if (op_.result < 0) {
+            throw std::system_error(-op_.result, std::generic_category(), "coro::IoReactor");
+        }
+        return static_cast<std::size_t>(op_.result);
+    }
+
+private:
+    IoReactor& reactor_;
+    detail::IoOperation op_;
+};
+
+class IoReactor {
+public:
+    struct Stats {
+        std::uint64_t operations = 0;    // Completed reads/writes
+        std::uint64_t submit_calls = 0;  // io_uring_enter calls (io_uring backend)
+    };
+
+    explicit IoReactor(IoReactorOptions options = {}) : resume_on_(options.resume_on) {
+        registered_.reserve(options.fixed_buffers.size());
+        for (auto buffer : options.fixed_buffers) registered_.push_back(iovec{buffer.data(), buffer.size()});
+#ifdef CORO_HAS_IO_URING
+        if (options.backend != IoBackend::ThreadPool) {
+            const int error = setup_ring(options.queue_depth);
+            if (error == 0) {
+                backend_ = IoBackend::IoUring;
+                threads_.emplace_back([this] { run_ring(); });
+                reactor_thread_id_ = threads_.back().get_id();
+                return;
+            }
+            if (options.backend == IoBackend::IoUring) {
+                throw std::system_error(error, std::generic_category(), "io_uring_setup");
+            }
+        }
+#else
+        if (options.backend == IoBackend::IoUring) {
+            throw std::runtime_error("coro::IoReactor: io_uring is not available on this platform");
+        }
+#endif
+        backend_ = IoBackend::ThreadPool;
+        const std::size_t workers = options.fallback_threads == 0 ? 1 : options.fallback_threads;
+        for (std::size_t i = 0; i < workers; ++i) {
+            threads_.emplace_back([this] { run_workers(); });
+        }
+    }
+
+    // All operations must have completed before the reactor is destroyed
+    ~IoReactor() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        work_available_.notify_all();
+#ifdef CORO_HAS_IO_URING
+        if (backend_ == IoBackend::IoUring) wake_ring();
+#endif
+        threads_.clear();
+#ifdef CORO_HAS_IO_URING
+        teardown_ring();
+#endif
+    }
+
+    IoReactor(const IoReactor&) = delete;
+    IoReactor& operator=(const IoReactor&) = delete;
+
+    // Process-wide reactor used by async_read/async_write
+    static IoReactor& instance() {
+        static IoReactor reactor;
+        return reactor;
+    }
+
+    IoBackend backend() const noexcept { return backend_; }
+
+    Stats stats() const noexcept {
+        return Stats{operations_.load(std::memory_order_relaxed), submit_calls_.load(std::memory_order_relaxed)};
+    }
+
+    IoAwaiter read(int fd, std::span<std::byte> buffer, std::uint64_t offset) {
+        return IoAwaiter{*this, make_op(detail::IoOperation::Kind::Read, fd, buffer.data(), buffer.size(), offset)};
+    }
+
+    IoAwaiter write(int fd, std::span<const std::byte> buffer, std::uint64_t offset) {
+        return IoAwaiter{*this, make_op(detail::IoOperation::Kind::Write, fd,
+                                        const_cast<std::byte*>(buffer.data()), buffer.size(), offset)};
+    }
+
+    // Reads into IoReactorOptions::fixed_buffers[index]; the data lands there
+    IoAwaiter read_fixed(int fd, unsigned index, std::size_t length, std::uint64_t offset) {
+        auto op = make_op(detail::IoOperation::Kind::ReadFixed, fd, fixed_buffer(index, length), length, offset);
+        op.buffer_index = index;
+        return IoAwaiter{*this, op};
+    }
+
+    IoAwaiter write_fixed(int fd, unsigned index, std::size_t length, std::uint64_t offset) {
+        auto op = make_op(detail::IoOperation::Kind::WriteFixed, fd, fixed_buffer(index, length), length, offset);
+        op.buffer_index = index;
+        return IoAwaiter{*this, op};
+    }
+
+private:
+    friend class IoAwaiter;
+
+    static detail::IoOperation make_op(detail::IoOperation::Kind kind, int fd, void* data,
+                                       std::size_t length, std::uint64_t offset) {
+        if (length > 0x7fffffffu) throw std::length_error("coro::IoReactor: single transfer too large");
+        detail::IoOperation op;
+        op.kind = kind;
+        op.fd = fd;
+        op.data = data;
+        op.length = static_cast<unsigned>(length);
+        op.offset = offset;
+        return op;
+    }
+
+    void* fixed_buffer(unsigned index, std::size_t length) const {
+        if (index >= registered_.size() || length > registered_[index].iov_len) {
+            throw std::out_of_range("coro::IoReactor: bad registered buffer");
+        }
+        return registered_[index].iov_base;
+    }
+
+    void submit(detail::IoOperation* op) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.push_back(op);
+        }
+#ifdef CORO_HAS_IO_URING
+        if (backend_ == IoBackend::IoUring) {
+            // The reactor thread drains the queue on its own before waiting again
+            if (std::this_thread::get_id() != reactor_thread_id_ &&
+                !wake_pending_.exchange(true, std::memory_order_acq_rel)) {
+                wake_ring();
+            }
+            return;
+        }
+#endif
+        work_available_.notify_one();
+    }
+
+    void complete(detail::IoOperation* op) {
+        operations_.fetch_add(1, std::memory_order_relaxed);
+        if (resume_on_) {
+            resume_on_->post(op->handle);
+        } else {
+            op->handle.resume();
+        }
+    }
+
+    // ---- Thread pool backend -------------------------------------------------
+
+    void run_workers() {
+        for (;;) {
+            detail::IoOperation* op = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                work_available_.wait(lock, [this] { return !pending_.empty() || stopping_; });
+                if (pending_.empty()) return;
+                op = pending_.front();  // FIFO, so the oldest request cannot starve
+                pending_.pop_front();
+            }
+            perform_blocking(*op);
+            complete(op);
+        }
+    }
+
+    static void perform_blocking(detail::IoOperation& op) {
+        ssize_t n = 0;
+        do {
+            switch (op.kind) {
+            case detail::IoOperation::Kind::Read:
+            case detail::IoOperation::Kind::ReadFixed:
+                n = ::pread(op.fd, op.data, op.length, static_cast<off_t>(op.offset));
+                break;
+            case detail::IoOperation::Kind::Write:
+            case detail::IoOperation::Kind::WriteFixed:
+                n = ::pwrite(op.fd, op.data, op.length, static_cast<off_t>(op.offset));
+                break;
+            }
+        } while (n < 0 && errno == EINTR);
+        op.result = n < 0 ? -errno : static_cast<int>(n);
+    }
+
+#ifdef CORO_HAS_IO_URING
+    // ---- io_uring backend ----------------------------------------------------
+
+    static constexpr std::uint64_t kWakeTag = 0;  // user_data of the eventfd read
+
+    int setup_ring(unsigned entries) {
+        io_uring_params params{};
+        const long fd = syscall(__NR_io_uring_setup, entries, &params);
+        if (fd < 0) return errno;
+        ring_fd_ = static_cast<int>(fd);
+
+        sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap) sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+        sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          ring_fd_, IORING_OFF_SQ_RING);
+        if (sq_ring_ == MAP_FAILED) return fail_setup();
+        cq_ring_ = single_mmap ? sq_ring_
+                               : ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                                        MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+        if (cq_ring_ == MAP_FAILED) return fail_setup();
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                            ring_fd_, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) return fail_setup();
+        sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+        auto* sq = static_cast<char*>(sq_ring_);
+        auto* cq = static_cast<char*>(cq_ring_);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        // One slot stays reserved for the wake-up read
+        capacity_ = std::min(params.sq_entries, params.cq_entries) - 1;
+
+        wake_fd_ = ::eventfd(0, EFD_CLOEXEC);
+        if (wake_fd_ < 0) return fail_setup();
+
+        // Older kernels register buffers only once the ring is idle, which it
+        // never is while the eventfd read is armed, so they are pinned here,
+        // before run_ring() starts
+        if (!registered_.empty() &&
+            syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_BUFFERS, registered_.data(),
+                    static_cast<unsigned>(registered_.size())) < 0) {
+            return fail_setup();
+        }
+        return 0;
+    }
+
+    int fail_setup() {
+        const int error = errno;
+        teardown_ring();
+        return error;
+    }
+
+    void teardown_ring() {
+        if (sqes_) ::munmap(sqes_, sqes_size_);
+        if (cq_ring_ && cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_) ::munmap(cq_ring_, cq_ring_size_);
+        if (sq_ring_ && sq_ring_ != MAP_FAILED) ::munmap(sq_ring_, sq_ring_size_);
+        if (wake_fd_ >= 0) ::close(wake_fd_);
+        if (ring_fd_ >= 0) ::close(ring_fd_);
+        sqes_ = nullptr;
+        sq_ring_ = cq_ring_ = nullptr;
+        wake_fd_ = ring_fd_ = -1;
+    }
+
+    void wake_ring() {
+        const std::uint64_t one = 1;
+        [[maybe_unused]] const auto written = ::write(wake_fd_, &one, sizeof(one));
+    }
+
+    io_uring_sqe& next_sqe() {
+        const unsigned tail = std::atomic_ref<unsigned>(*sq_tail_).load(std::memory_order_relaxed) + to_submit_;
+        const unsigned index = tail & sq_mask_;
+        sq_array_[index] = index;
+        ++to_submit_;
+        io_uring_sqe& sqe = sqes_[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        return sqe;
+    }
+
+    void queue_wake_read() {
+        io_uring_sqe& sqe = next_sqe();
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = wake_fd_;
+        sqe.addr = reinterpret_cast<std::uint64_t>(&wake_buffer_);
+        sqe.len = sizeof(wake_buffer_);
+        sqe.user_data = kWakeTag;
+    }
+
+    void queue_operation(detail::IoOperation* op) {
+        io_uring_sqe& sqe = next_sqe();
+        switch (op->kind) {
+        case detail::IoOperation::Kind::Read: sqe.opcode = IORING_OP_READ; break;
+        case detail::IoOperation::Kind::Write: sqe.opcode = IORING_OP_WRITE; break;
+        case detail::IoOperation::Kind::ReadFixed: sqe.opcode = IORING_OP_READ_FIXED; break;
+        case detail::IoOperation::Kind::WriteFixed: sqe.opcode = IORING_OP_WRITE_FIXED; break;
+        }
+        sqe.fd = op->fd;
+        sqe.off = op->offset;
+        sqe.addr = reinterpret_cast<std::uint64_t>(op->data);
+        sqe.len = op->length;
+        sqe.buf_index = static_cast<std::uint16_t>(op->buffer_index);
+        sqe.user_data = reinterpret_cast<std::uint64_t>(op);
+    }
+
+    void run_ring() {
+        std::vector<detail::IoOperation*> backlog;
+        unsigned in_flight = 0;    // Handed to the ring, not completed yet
+        unsigned unsubmitted = 0;  // Published in the SQ, not consumed by the kernel yet
+        queue_wake_read();
+
+        for (;;) {
+            if (ring_failed_) wake_pending_.store(false, std::memory_order_release);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (stopping_ && pending_.empty() && backlog.empty() && in_flight == 0) break;
+                backlog.insert(backlog.end(), pending_.begin(), pending_.end());
+                pending_.clear();
+            }
+
+            if (ring_failed_) {
+                serve_without_ring(backlog, in_flight);
+                continue;
+            }
+
+            // Everything queued since the last wake-up goes out as one batch
+            std::size_t taken = 0;
+            while (taken < backlog.size() && in_flight < capacity_) {
+                queue_operation(backlog[taken++]);
+                ++in_flight;
+            }
+            backlog.erase(backlog.begin(), backlog.begin() + static_cast<std::ptrdiff_t>(taken));
+
+            std::atomic_ref<unsigned>(*sq_tail_).fetch_add(to_submit_, std::memory_order_release);
+            const unsigned submitting = unsubmitted + to_submit_;
+            to_submit_ = 0;
+            long rc;
+            do {
+                rc = syscall(__NR_io_uring_enter, ring_fd_, submitting, 1u, IORING_ENTER_GETEVENTS, nullptr, 0);
+            } while (rc < 0 && errno == EINTR);
+            const int error = rc < 0 ? errno : 0;
+            submit_calls_.fetch_add(1, std::memory_order_relaxed);
+
+            if (rc >= 0) {
+                // A short submit leaves the rest in the SQ for the next call
+                unsubmitted = submitting - static_cast<unsigned>(rc);
+            } else if (error == EAGAIN || error == EBUSY || error == ENOMEM) {
+                // Out of resources: nothing was consumed; retry once completions drain
+                unsubmitted = submitting;
+            } else {
+                // The ring is unusable. What it never took runs on this thread
+                // with blocking I/O instead, ahead of anything queued later.
+                ring_failed_ = true;
+                auto reclaimed = take_unsubmitted(submitting);
+                in_flight -= static_cast<unsigned>(reclaimed.size());
+                backlog.insert(backlog.begin(), reclaimed.begin(), reclaimed.end());
+                unsubmitted = 0;
+            }
+
+            const unsigned reaped = reap_completions();
+            in_flight -= reaped;
+            if (rc < 0 && reaped == 0 && !ring_failed_) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+    // Consumes the CQ and resumes the finished operations; returns how many
+    unsigned reap_completions() {
+        unsigned head = std::atomic_ref<unsigned>(*cq_head_).load(std::memory_order_relaxed);
+        const unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+        std::vector<detail::IoOperation*> done;
+        for (; head != tail; ++head) {
+            const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+            if (cqe.user_data == kWakeTag) {
+                wake_pending_.store(false, std::memory_order_release);
+                if (!ring_failed_) queue_wake_read();
+                continue;
+            }
+            auto* op = reinterpret_cast<detail::IoOperation*>(cqe.user_data);
+            op->result = cqe.res;
+            done.push_back(op);
+        }
+        std::atomic_ref<unsigned>(*cq_head_).store(head, std::memory_order_release);
+
+        // Resume after releasing the CQ slots: resumed coroutines queue more work
+        for (auto* op : done) complete(op);
+        return static_cast<unsigned>(done.size());
+    }
+
+    // The operations in the last `count` SQ entries, which the kernel never read
+    std::vector<detail::IoOperation*> take_unsubmitted(unsigned count) {
+        std::vector<detail::IoOperation*> ops;
+        const unsigned tail = std::atomic_ref<unsigned>(*sq_tail_).load(std::memory_order_relaxed);
+        for (unsigned position = tail - count; position != tail; ++position) {
+            const std::uint64_t tag = sqes_[sq_array_[position & sq_mask_]].user_data;
+            if (tag != kWakeTag) ops.push_back(reinterpret_cast<detail::IoOperation*>(tag));
+        }
+        return ops;
+    }
+
+    // After io_uring_enter failed for good: blocking I/O on the reactor
+    // thread, while operations already in the kernel still drain from the CQ
+    void serve_without_ring(std::vector<detail::IoOperation*>& backlog, unsigned& in_flight) {
+        if (!backlog.empty()) {
+            auto batch = std::exchange(backlog, {});
+            for (auto* op : batch) {
+                perform_blocking(*op);
+                complete(op);
+            }
+        } else if (in_flight != 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            in_flight -= reap_completions();
+        } else {
+            // Submitters write the eventfd now that wake_pending_ is clear
+            std::uint64_t count = 0;
+            [[maybe_unused]] const auto got = ::read(wake_fd_, &count, sizeof(count));
+        }
+    }
+
+    int ring_fd_ = -1;
+    int wake_fd_ = -1;
+    std::uint64_t wake_buffer_ = 0;
+    std::atomic<bool> wake_pending_{false};
+    std::thread::id reactor_thread_id_;
+    void* sq_ring_ = nullptr;
+    void* cq_ring_ = nullptr;
+    std::size_t sq_ring_size_ = 0;
+    std::size_t cq_ring_size_ = 0;
+    std::size_t sqes_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned cq_mask_ = 0;
+    unsigned capacity_ = 0;
+    unsigned to_submit_ = 0;
+    bool ring_failed_ = false;  // Reactor thread only
+#endif
+
+    IoBackend backend_ = IoBackend::ThreadPool;
+    ThreadPool* resume_on_ = nullptr;
+    std::vector<iovec> registered_;
+    std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::deque<detail::IoOperation*> pending_;
+    bool stopping_ = false;
+    std::atomic<std::uint64_t> operations_{0};
+    std::atomic<std::uint64_t> submit_calls_{0};
+    std::vector<std::jthread> threads_;  // Last: joined before the rest is destroyed
+};
+
+inline void IoAwaiter::await_suspend(std::coroutine_handle<> h) {
+    op_.handle = h;
+    reactor_.submit(&op_);
+}
+
+// co_await async_read(fd, buffer, offset) on the process-wide reactor
+inline IoAwaiter async_read(int fd, std::span<std::byte> buffer, std::uint64_t offset) {
+    return IoReactor::instance().read(fd, buffer, offset);
+}
+
+inline IoAwaiter async_write(int fd, std::span<const std::byte> buffer, std::uint64_t offset) {
+    return IoReactor::instance().write(fd, buffer, offset);
+}
+
+} // namespace coro
+
+#endif // CORO_HAS_ASYNC_FILE_IO
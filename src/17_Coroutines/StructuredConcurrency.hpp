@@ -0,0 +1,410 @@
+#pragma once
+
+#include "AsyncTask.hpp"
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <stop_token>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace coro {
+
+// ============================================================================
+// Structured concurrency: when_all, when_any, deadlines and task groups
+// ============================================================================
+// Every combinator here starts its children concurrently, gives them a
+// stop token linked to the parent's, and resumes the parent only after
+// ALL children have finished - losers and failed siblings included. A
+// child that hits a cancellable awaiter (sleep_for, cancellation_point,
+// ...) after stop is requested finishes promptly with operation_cancelled.
+
+namespace detail {
+
+// Counts outstanding children plus one reference held by the awaiting
+// parent; whoever drops it to zero resumes the parent.
+struct CompletionCounter {
+    explicit CompletionCounter(std::size_t initial) noexcept : pending(initial) {}
+
+    std::coroutine_handle<> arrive() noexcept {
+        if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) return waiter;
+        return std::noop_coroutine();
+    }
+
+    std::atomic<std::size_t> pending;
+    std::coroutine_handle<> waiter = std::noop_coroutine();
+};
+
+// First exception wins; later ones (often cancellations it caused) are dropped
+struct FirstError {
+    void capture(std::exception_ptr error) noexcept {
+        if (!set.exchange(true, std::memory_order_acq_rel)) value = std::move(error);
+    }
+
+    void rethrow_if_set() const {
+        if (set.load(std::memory_order_acquire) && value) std::rethrow_exception(value);
+    }
+
+    std::atomic<bool> set{false};
+    std::exception_ptr value;
+};
+
+// Frame that runs one child to completion and then reports to a counter.
+// Reporting happens in final_suspend, after this frame is suspended, so the
+// resumed parent may destroy it immediately.
+class ChildRunner {
+public:
+    struct promise_type {
+        CompletionCounter* counter = nullptr;
+
+        ChildRunner get_return_object() noexcept {
+            return ChildRunner{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                return h.promise().counter->arrive();
+            }
+            void await_resume() const noexcept {}
+        };
+
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }  // Bodies catch everything
+    };
+
+    explicit ChildRunner(std::coroutine_handle<promise_type> h) noexcept : handle_(h) {}
+    ChildRunner(ChildRunner&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    ChildRunner& operator=(ChildRunner&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    ~ChildRunner() {
+        if (handle_) handle_.destroy();
+    }
+
+    void start(CompletionCounter& counter) {
+        handle_.promise().counter = &counter;
+        handle_.resume();
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+// Starts every child, then drops the parent's own reference. Suspends only
+// if some child is still running at that point.
+struct StartAndWait {
+    CompletionCounter& counter;
+    std::vector<ChildRunner>& children;
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> parent) {
+        counter.waiter = parent;
+        for (auto& child : children) child.start(counter);
+        return counter.pending.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+
+    void await_resume() const noexcept {}
+};
+
+struct RequestStop {
+    std::stop_source* source;
+    void operator()() const noexcept { source->request_stop(); }
+};
+
+// Fail-fast: the first error stops the siblings
+template <typename T>
+ChildRunner run_all_child(Task<T>& task, std::optional<NonVoid<T>>& slot,
+                          FirstError& error, std::stop_source& group) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await task;
+            slot.emplace();
+        } else {
+            slot.emplace(co_await task);
+        }
+    } catch (...) {
+        error.capture(std::current_exception());
+        group.request_stop();
+    }
+}
+
+// First success wins and stops the others
+template <typename T>
+ChildRunner run_any_child(Task<T>& task, std::size_t index, std::optional<T>& slot,
+                          std::atomic<bool>& decided, std::size_t& winner,
+                          FirstError& error, std::stop_source& group) {
+    try {
+        T value = co_await task;
+        if (!decided.exchange(true, std::memory_order_acq_rel)) {
+            slot.emplace(std::move(value));
+            winner = index;
+            group.request_stop();
+        }
+    } catch (...) {
+        error.capture(std::current_exception());
+    }
+}
+
+// Deadline race entrant: the task's value or error, or neither if the timer won
+template <typename T>
+struct Settled {
+    std::optional<T> value;
+    std::exception_ptr error;
+};
+
+// Turns a failure into a completion so it ends the race like a success does
+template <typename T>
+Task<Settled<T>> settle(Task<T> task) {
+    Settled<T> out;
+    try {
+        T value = co_await task;
+        out.value.emplace(std::move(value));
+    } catch (...) {
+        out.error = std::current_exception();
+    }
+    co_return out;
+}
+
+template <typename T>
+Task<Settled<T>> expire_at(Clock::time_point deadline) {
+    co_await sleep_until(deadline);
+    co_return Settled<T>{};
+}
+
+template <typename... Ts, std::size_t... Is>
+void launch_all(std::tuple<Task<Ts>...>& tasks, std::tuple<std::optional<NonVoid<Ts>>...>& slots,
+                FirstError& error, std::stop_source& group, std::vector<ChildRunner>& children,
+                std::index_sequence<Is...>) {
+    (std::get<Is>(tasks).set_stop_token(group.get_token()), ...);
+    (children.push_back(run_all_child(std::get<Is>(tasks), std::get<Is>(slots), error, group)), ...);
+}
+
+} // namespace detail
+
+// All results, in input order. Fails fast: the first exception requests
+// stop on the remaining children, waits for them, then is rethrown.
+template <typename T>
+    requires (!std::is_void_v<T>)
+Task<std::vector<T>> when_all(std::vector<Task<T>> tasks) {
+    std::stop_source group;
+    std::stop_callback link(co_await get_stop_token(), detail::RequestStop{&group});
+
+    std::vector<std::optional<T>> slots(tasks.size());
+    detail::FirstError error;
+    detail::CompletionCounter counter{tasks.size() + 1};
+    std::vector<detail::ChildRunner> children;
+    children.reserve(tasks.size());
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        tasks[i].set_stop_token(group.get_token());
+        children.push_back(detail::run_all_child(tasks[i], slots[i], error, group));
+    }
+
+    co_await detail::StartAndWait{counter, children};
+    error.rethrow_if_set();
+
+    std::vector<T> results;
+    results.reserve(slots.size());
+    for (auto& slot : slots) results.push_back(std::move(*slot));
+    co_return results;
+}
+
+// Heterogeneous form: co_await when_all(task_a(), task_b()) -> tuple
+template <typename... Ts>
+    requires (sizeof...(Ts) > 0 && (!std::is_void_v<Ts> && ...))
+Task<std::tuple<Ts...>> when_all(Task<Ts>... input) {
+    std::stop_source group;
+    std::stop_callback link(co_await get_stop_token(), detail::RequestStop{&group});
+
+    std::tuple<Task<Ts>...> tasks{std::move(input)...};
+    std::tuple<std::optional<Ts>...> slots;
+    detail::FirstError error;
+    detail::CompletionCounter counter{sizeof...(Ts) + 1};
+    std::vector<detail::ChildRunner> children;
+    children.reserve(sizeof...(Ts));
+    detail::launch_all(tasks, slots, error, group, children, std::index_sequence_for<Ts...>{});
+
+    co_await detail::StartAndWait{counter, children};
+    error.rethrow_if_set();
+
+    co_return std::apply([](auto&... slot) { return std::tuple<Ts...>{std::move(*slot)...}; }, slots);
+}
+
+// First successful result and its index. The losers are cancelled and
+// awaited before this returns; if every child fails, the first error is
+// rethrown.
+template <typename T>
+    requires (!std::is_void_v<T>)
+Task<std::pair<std::size_t, T>> when_any(std::vector<Task<T>> tasks) {
+    if (tasks.empty()) throw std::invalid_argument("coro::when_any: no tasks");
+
+    std::stop_source group;
+    std::stop_callback link(co_await get_stop_token(), detail::RequestStop{&group});
+
+    std::optional<T> result;
+    std::atomic<bool> decided{false};
+    std::size_t winner = 0;
+    detail::FirstError error;
+    detail::CompletionCounter counter{tasks.size() + 1};
+    std::vector<detail::ChildRunner> children;
+    children.reserve(tasks.size());
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        tasks[i].set_stop_token(group.get_token());
+        children.push_back(detail::run_any_child(tasks[i], i, result, decided, winner, error, group));
+    }
+
+    co_await detail::StartAndWait{counter, children};
+    if (!result) {
+        error.rethrow_if_set();
+        throw operation_cancelled{};
+    }
+    co_return std::pair<std::size_t, T>{winner, std::move(*result)};
+}
+
+template <typename T, typename... Rest>
+    requires (std::same_as<Task<T>, Rest> && ...)
+Task<std::pair<std::size_t, T>> when_any(Task<T> first, Rest... rest) {
+    std::vector<Task<T>> tasks;
+    tasks.reserve(1 + sizeof...(Rest));
+    tasks.push_back(std::move(first));
+    (tasks.push_back(std::move(rest)), ...);
+    co_return co_await when_any(std::move(tasks));
+}
+
+// Latency budget: nullopt if the deadline passes first, in which case the
+// task is cancelled (and still awaited, so nothing outlives this call). A
+// task that fails before the deadline ends the race too; its error is
+// rethrown rather than waiting out the budget.
+template <typename T>
+    requires (!std::is_void_v<T>)
+Task<std::optional<T>> with_deadline(Task<T> task, Clock::time_point deadline) {
+    std::vector<Task<detail::Settled<T>>> racers;
+    racers.push_back(detail::settle(std::move(task)));
+    racers.push_back(detail::expire_at<T>(deadline));
+    auto [index, outcome] = co_await when_any(std::move(racers));
+    (void)index;
+    if (outcome.error) std::rethrow_exception(outcome.error);
+    co_return std::move(outcome.value);
+}
+
+template <typename T, typename Rep, typename Period>
+Task<std::optional<T>> with_timeout(Task<T> task, std::chrono::duration<Rep, Period> budget) {
+    return with_deadline(std::move(task),
+                         Clock::now() + std::chrono::duration_cast<Clock::duration>(budget));
+}
+
+// ============================================================================
+// TaskGroup - a nursery whose children cannot outlive it
+// ============================================================================
+// spawn() starts a child immediately (it runs inline until its first
+// suspension). co_await join() resumes once every child has finished and
+// rethrows the first child failure. Destroying a group with children still
+// running is a bug in the caller, treated like destroying a joinable
+// std::thread: std::terminate(). task_scope() wraps the
+// spawn-then-join pattern so the join cannot be forgotten.
+
+class TaskGroup {
+public:
+    explicit TaskGroup(std::stop_token parent = {}) {
+        if (parent.stop_possible()) link_.emplace(std::move(parent), detail::RequestStop{&source_});
+    }
+
+    ~TaskGroup() {
+        if (counter_.pending.load(std::memory_order_acquire) != 1) std::terminate();
+    }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void spawn(Task<void> task) {
+        task.set_stop_token(source_.get_token());
+        counter_.pending.fetch_add(1, std::memory_order_relaxed);
+        children_.push_back(run_child(std::move(task), error_, source_));
+        children_.back().start(counter_);
+    }
+
+    void request_stop() noexcept { source_.request_stop(); }
+    std::stop_token get_stop_token() const noexcept { return source_.get_token(); }
+
+    auto join() noexcept {
+        struct JoinAwaiter {
+            TaskGroup& group;
+
+            bool await_ready() const noexcept { return false; }
+
+            bool await_suspend(std::coroutine_handle<> parent) noexcept {
+                group.counter_.waiter = parent;
+                return group.counter_.pending.fetch_sub(1, std::memory_order_acq_rel) != 1;
+            }
+
+            void await_resume() {
+                // Every child is done: reclaim frames and re-arm for reuse
+                group.children_.clear();
+                group.counter_.waiter = std::noop_coroutine();
+                group.counter_.pending.store(1, std::memory_order_release);
+                group.error_.rethrow_if_set();
+            }
+        };
+        return JoinAwaiter{*this};
+    }
+
+private:
+    static detail::ChildRunner run_child(Task<void> task, detail::FirstError& error,
+                                         std::stop_source& source) {
+        try {
+            co_await task;
+        } catch (...) {
+            error.capture(std::current_exception());
+            source.request_stop();
+        }
+    }
+
+    std::stop_source source_;
+    std::optional<std::stop_callback<detail::RequestStop>> link_;
+    detail::CompletionCounter counter_{1};
+    detail::FirstError error_;
+    std::vector<detail::ChildRunner> children_;
+};
+
+// co_await task_scope([&](TaskGroup& group) -> Task<void> { group.spawn(...); co_return; });
+// The body's children are always joined before task_scope completes, even
+// when the body throws (which also cancels them).
+template <typename F>
+    requires std::invocable<F&, TaskGroup&>
+Task<void> task_scope(F body) {
+    TaskGroup group(co_await get_stop_token());
+    std::exception_ptr body_error;
+    try {
+        co_await body(group);
+    } catch (...) {
+        body_error = std::current_exception();
+        group.request_stop();
+    }
+
+    std::exception_ptr child_error;
+    try {
+        co_await group.join();
+    } catch (...) {
+        child_error = std::current_exception();
+    }
+
+    if (body_error) std::rethrow_exception(body_error);
+    if (child_error) std::rethrow_exception(child_error);
+}
+
+} // namespace coro
@@ -1,8 +1,14 @@
 #include "ISPSample.hpp"
 #include "BadExample.hpp"
 #include "GoodExample.hpp"
+#include "JobScheduler.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
 #include <memory>
+#include <random>
+#include <thread>
 
 // Use anonymous namespace to ensure internal linkage and avoid ODR violations
 namespace {
@@ -111,6 +117,152 @@ void demonstrate_good_repository() {
     repo.backup();
 }
 
+void demonstrate_job_scheduler() {
+    std::cout << "\n=== GOOD: Capability-Aware Job Scheduler ===" << std::endl;
+    std::cout << "Jobs are routed only to devices that implement the needed interface\n" << std::endl;
+
+    isp_sched::JobScheduler scheduler;
+    scheduler.addDevice("printer", std::make_shared<isp_good::SimplePrinter>());
+    scheduler.addDevice("scanner", std::make_shared<isp_good::SimpleScanner>());
+    scheduler.addDevice("mfp", std::make_shared<isp_good::MultiFunctionPrinter>());
+
+    using isp_sched::JobKind;
+    using isp_sched::Priority;
+
+    // Waiting on each future keeps the demo output ordered
+    std::cout << "  Fax (only the MFP implements IFax):" << std::endl;
+    scheduler.submit({JobKind::Fax, Priority::Urgent, "contract.pdf"}).get();
+
+    std::cout << "\n  Scan-to-print pipeline (IScanner stage -> IPrinter stage):" << std::endl;
+    scheduler.submit({JobKind::ScanToPrint, Priority::Normal, "", 1, 2}).get();
+
+    std::cout << "\n  Copy (routed to the ICopier):" << std::endl;
+    scheduler.submit({JobKind::Copy, Priority::Bulk, "", 1, 3}).get();
+
+    scheduler.shutdown();
+    std::cout << "\n  Per-device jobs completed:" << std::endl;
+    for (const auto& s : scheduler.stats()) {
+        std::cout << "    " << std::left << std::setw(8) << s.name << std::right
+                  << s.jobsCompleted << std::endl;
+    }
+}
+
+// Quiet stand-ins with a fixed service time, used to drive a print farm
+class SimulatedPrinter : public isp_good::IPrinter {
+public:
+    explicit SimulatedPrinter(std::chrono::microseconds latency) : latency_(latency) {}
+    void print(const std::string&) override { std::this_thread::sleep_for(latency_); }
+private:
+    std::chrono::microseconds latency_;
+};
+
+class SimulatedScanner : public isp_good::IScanner {
+public:
+    explicit SimulatedScanner(std::chrono::microseconds latency) : latency_(latency) {}
+    std::string scan() override {
+        std::this_thread::sleep_for(latency_);
+        return "page";
+    }
+private:
+    std::chrono::microseconds latency_;
+};
+
+class SimulatedMfp : public isp_good::IPrinter, public isp_good::IScanner,
+                     public isp_good::IFax, public isp_good::ICopier {
+public:
+    explicit SimulatedMfp(std::chrono::microseconds latency) : latency_(latency) {}
+    void print(const std::string&) override { std::this_thread::sleep_for(latency_); }
+    std::string scan() override {
+        std::this_thread::sleep_for(latency_);
+        return "page";
+    }
+    void fax(const std::string&) override { std::this_thread::sleep_for(latency_); }
+    void copy(int) override { std::this_thread::sleep_for(latency_); }
+private:
+    std::chrono::microseconds latency_;
+};
+
+void run_print_farm(const char* label, isp_sched::SchedulerConfig config) {
+    using namespace std::chrono;
+    using isp_sched::JobKind;
+    using isp_sched::Priority;
+
+    constexpr int kPrinters = 50;
+    constexpr int kScanners = 30;
+    constexpr int kMfps = 20;
+    constexpr int kJobs = 4000;
+    constexpr microseconds kServiceTime{100};
+
+    isp_sched::JobScheduler scheduler(config);
+    for (int i = 0; i < kPrinters; ++i) {
+        scheduler.addDevice("printer" + std::to_string(i), std::make_shared<SimulatedPrinter>(kServiceTime));
+    }
+    for (int i = 0; i < kScanners; ++i) {
+        scheduler.addDevice("scanner" + std::to_string(i), std::make_shared<SimulatedScanner>(kServiceTime));
+    }
+    for (int i = 0; i < kMfps; ++i) {
+        scheduler.addDevice("mfp" + std::to_string(i), std::make_shared<SimulatedMfp>(kServiceTime));
+    }
+
+    // Mostly small print jobs, with scans, faxes, copies and scan-to-print pipelines
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> pick(0, 99);
+    const auto start = steady_clock::now();
+    for (int i = 0; i < kJobs; ++i) {
+        const int roll = pick(rng);
+        isp_sched::JobRequest job;
+        job.priority = roll % 10 == 0 ? Priority::Urgent : (roll % 3 == 0 ? Priority::Bulk : Priority::Normal);
+        if (roll < 60)      { job.kind = JobKind::Print; job.document = "doc"; }
+        else if (roll < 75) { job.kind = JobKind::Scan; }
+        else if (roll < 85) { job.kind = JobKind::Fax; job.document = "fax"; }
+        else if (roll < 90) { job.kind = JobKind::Copy; }
+        else                { job.kind = JobKind::ScanToPrint; }
+        job.pages = roll % 7 == 0 ? 20 : 1;
+        scheduler.submit(std::move(job));
+    }
+    scheduler.drain();
+    const duration<double> wall = steady_clock::now() - start;
+
+    const auto stats = scheduler.stats();
+    std::uint64_t jobs = 0;
+    std::uint64_t batches = 0;
+    microseconds totalLatency{0};
+    microseconds maxLatency{0};
+    for (const auto& s : stats) {
+        jobs += s.jobsCompleted;
+        batches += s.batches;
+        totalLatency += s.totalLatency;
+        maxLatency = std::max(maxLatency, s.maxLatency);
+    }
+    const auto busiest = std::max_element(stats.begin(), stats.end(),
+        [](const auto& a, const auto& b) { return a.jobsCompleted < b.jobsCompleted; });
+
+    std::cout << "  " << label << ":" << std::endl;
+    std::cout << "    devices: " << scheduler.deviceCount() << ", stages completed: " << jobs
+              << ", worker wake-ups: " << batches << std::endl;
+    std::cout << "    wall time: " << duration_cast<milliseconds>(wall).count() << " ms, throughput: "
+              << static_cast<long long>(static_cast<double>(jobs) / wall.count()) << " stages/s" << std::endl;
+    std::cout << "    avg latency: " << (jobs ? totalLatency.count() / static_cast<long long>(jobs) : 0)
+              << " us, max latency: " << maxLatency.count() << " us" << std::endl;
+    std::cout << "    busiest device: " << busiest->name << " (" << busiest->jobsCompleted << " jobs, "
+              << static_cast<long long>(busiest->throughput(wall)) << " jobs/s, avg "
+              << busiest->averageLatency().count() << " us)" << std::endl;
+}
+
+void demonstrate_scheduler_benchmark() {
+    std::cout << "\n=== Print Farm Benchmark (100 simulated devices) ===" << std::endl;
+    std::cout << "Each worker wake-up pays a 2ms simulated warm-up\n" << std::endl;
+
+    isp_sched::SchedulerConfig unbatched;
+    unbatched.maxBatch = 1;
+    unbatched.batchSetup = std::chrono::microseconds{2000};
+    run_print_farm("one job per wake-up", unbatched);
+
+    isp_sched::SchedulerConfig batched = unbatched;
+    batched.maxBatch = 8;
+    run_print_farm("small jobs batched (up to 8)", batched);
+}
+
 void demonstrate_isp_benefits() {
     std::cout << "\n=== Interface Segregation Benefits ===" << std::endl;
 
@@ -150,6 +302,8 @@ void ISPSample::run() {
     demonstrate_good_workers();
     demonstrate_good_devices();
     demonstrate_good_repository();
+    demonstrate_job_scheduler();
+    demonstrate_scheduler_benchmark();
     demonstrate_isp_benefits();
 
     std::cout << "\n=== Key Takeaways ===" << std::endl;
@@ -0,0 +1,410 @@
+#pragma once
+
+#include "GoodExample.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace isp_sched {
+
+// ============================================================================
+// Capability-aware job scheduler for segregated device interfaces
+// ============================================================================
+// The scheduler never asks a device for more than it implements: a device is
+// registered with whatever subset of IPrinter/IScanner/IFax/ICopier its type
+// derives from (detected at compile time), and every job is routed only to
+// devices that have the capability it needs. Each device owns a bounded
+// queue with priority lanes and a worker thread, so a farm of devices runs
+// in parallel while callers just submit jobs and wait on futures.
+
+using isp_good::ICopier;
+using isp_good::IFax;
+using isp_good::IPrinter;
+using isp_good::IScanner;
+
+using Clock = std::chrono::steady_clock;
+
+enum class JobKind {
+    Print,        // IPrinter
+    Scan,         // IScanner
+    Fax,          // IFax
+    Copy,         // ICopier (walk-up copier)
+    ScanToPrint   // pipeline: IScanner stage feeding an IPrinter stage
+};
+
+// Lower value = served first
+enum class Priority { Urgent = 0, Normal = 1, Bulk = 2 };
+inline constexpr std::size_t kPriorityLanes = 3;
+
+enum Capability : unsigned {
+    CanPrint = 1u << 0,
+    CanScan  = 1u << 1,
+    CanFax   = 1u << 2,
+    CanCopy  = 1u << 3
+};
+
+struct JobRequest {
+    JobKind kind = JobKind::Print;
+    Priority priority = Priority::Normal;
+    std::string document;
+    int pages = 1;   // Job size; jobs up to SchedulerConfig::smallJobPages are batched
+    int copies = 1;
+};
+
+struct SchedulerConfig {
+    std::size_t queueCapacity = 64;       // Per device, across all lanes
+    std::size_t maxBatch = 8;             // Small jobs handled per worker wake-up
+    int smallJobPages = 2;
+    std::chrono::microseconds batchSetup{0};  // Simulated warm-up paid once per batch
+};
+
+struct DeviceStats {
+    std::string name;
+    unsigned capabilities = 0;
+    std::uint64_t jobsCompleted = 0;
+    std::uint64_t batches = 0;
+    std::chrono::microseconds busyTime{0};
+    std::chrono::microseconds totalLatency{0};  // Enqueue-to-completion, summed
+    std::chrono::microseconds maxLatency{0};
+
+    std::chrono::microseconds averageLatency() const {
+        return jobsCompleted == 0
+            ? std::chrono::microseconds{0}
+            : totalLatency / static_cast<std::int64_t>(jobsCompleted);
+    }
+
+    double throughput(std::chrono::duration<double> wall) const {
+        return wall.count() > 0.0 ? static_cast<double>(jobsCompleted) / wall.count() : 0.0;
+    }
+};
+
+class JobScheduler {
+public:
+    explicit JobScheduler(SchedulerConfig config = {}) : config_(config) {
+        if (config_.maxBatch == 0) config_.maxBatch = 1;
+        if (config_.queueCapacity == 0) config_.queueCapacity = 1;
+    }
+
+    ~JobScheduler() { shutdown(); }
+
+    JobScheduler(const JobScheduler&) = delete;
+    JobScheduler& operator=(const JobScheduler&) = delete;
+
+    // Register a device before submitting jobs. Only the interfaces DeviceT
+    // actually implements become routable capabilities.
+    template <typename DeviceT>
+    void addDevice(std::string deviceName, std::shared_ptr<DeviceT> device) {
+        auto entry = std::make_unique<Device>(*this, std::move(deviceName));
+        if constexpr (std::is_base_of_v<IPrinter, DeviceT>) {
+            entry->printer = device;
+            entry->capabilities |= CanPrint;
+        }
+        if constexpr (std::is_base_of_v<IScanner, DeviceT>) {
+            entry->scanner = device;
+            entry->capabilities |= CanScan;
+        }
+        if constexpr (std::is_base_of_v<IFax, DeviceT>) {
+            entry->faxer = device;
+            entry->capabilities |= CanFax;
+        }
+        if constexpr (std::is_base_of_v<ICopier, DeviceT>) {
+            entry->copier = device;
+            entry->capabilities |= CanCopy;
+        }
+        static_assert(std::is_base_of_v<IPrinter, DeviceT> || std::is_base_of_v<IScanner, DeviceT> ||
+                      std::is_base_of_v<IFax, DeviceT> || std::is_base_of_v<ICopier, DeviceT>,
+                      "Device must implement at least one device interface");
+
+        for (std::size_t bit = 0; bit < routes_.size(); ++bit) {
+            if (entry->capabilities & (1u << bit)) routes_[bit].push_back(entry.get());
+        }
+        entry->start();
+        devices_.push_back(std::move(entry));
+    }
+
+    // Routes the job to the least-loaded capable device. Blocks while that
+    // device's queue is full (backpressure). Throws if no device can run it.
+    std::future<void> submit(JobRequest request) {
+        // Counted before the closed_ check (both seq_cst): a racing shutdown()
+        // either is seen here or finds this job in drain() and waits for it,
+        // so it never stops the device the job is about to enter
+        outstanding_.fetch_add(1);
+        try {
+            if (closed_.load()) {
+                throw std::runtime_error("JobScheduler: submit after shutdown");
+            }
+
+            Job job;
+            job.request = std::move(request);
+            job.continueToPrint = job.request.kind == JobKind::ScanToPrint;
+            if (job.continueToPrint) {
+                job.request.kind = JobKind::Scan;
+                route(JobKind::Print);  // Reject now rather than after the scan has run
+            }
+
+            Device& target = route(job.request.kind);
+            auto future = job.done.get_future();
+            target.push(std::move(job), /*bypassBound=*/false);
+            return future;
+        } catch (...) {
+            jobFinished();
+            throw;
+        }
+    }
+
+    // Wait until every submitted job, including pipeline follow-up stages, is done
+    void drain() {
+        std::unique_lock<std::mutex> lock(idleMutex_);
+        idle_.wait(lock, [this] { return outstanding_.load() == 0; });
+    }
+
+    // Graceful: finishes queued work, then stops the device workers
+    void shutdown() {
+        if (closed_.exchange(true)) return;
+        drain();
+        for (auto& device : devices_) device->stop();
+    }
+
+    std::vector<DeviceStats> stats() const {
+        std::vector<DeviceStats> result;
+        result.reserve(devices_.size());
+        for (const auto& device : devices_) result.push_back(device->snapshot());
+        return result;
+    }
+
+    std::size_t deviceCount() const { return devices_.size(); }
+
+private:
+    struct Job {
+        JobRequest request;
+        bool continueToPrint = false;
+        Clock::time_point enqueued;
+        std::promise<void> done;
+    };
+
+    class Device {
+    public:
+        Device(JobScheduler& owner, std::string deviceName)
+            : owner_(owner) {
+            stats_.name = std::move(deviceName);
+        }
+
+        std::shared_ptr<IPrinter> printer;
+        std::shared_ptr<IScanner> scanner;
+        std::shared_ptr<IFax> faxer;
+        std::shared_ptr<ICopier> copier;
+        unsigned capabilities = 0;
+
+        void start() {
+            stats_.capabilities = capabilities;
+            worker_ = std::jthread([this] { run(); });
+        }
+
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                closing_ = true;
+            }
+            notEmpty_.notify_all();
+            notFull_.notify_all();
+            if (worker_.joinable()) worker_.join();
+        }
+
+        // Pipeline follow-up stages bypass the bound: a started job must
+        // never deadlock waiting on a queue its own worker has to drain.
+        void push(Job job, bool bypassBound) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (!bypassBound) {
+                notFull_.wait(lock, [this] {
+                    return depth_.load(std::memory_order_relaxed) < owner_.config_.queueCapacity || closing_;
+                });
+            }
+            job.enqueued = Clock::now();
+            lanes_[static_cast<std::size_t>(job.request.priority)].push_back(std::move(job));
+            depth_.fetch_add(1, std::memory_order_relaxed);
+            notEmpty_.notify_one();
+        }
+
+        std::size_t depth() const { return depth_.load(std::memory_order_relaxed); }
+
+        DeviceStats snapshot() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return stats_;
+        }
+
+    private:
+        bool isSmall(const Job& job) const {
+            return job.request.pages <= owner_.config_.smallJobPages;
+        }
+
+        // Take the head of the highest-priority lane, plus any immediately
+        // following small jobs of the same kind so they share one wake-up.
+        std::vector<Job> takeBatch() {
+            std::vector<Job> batch;
+            for (auto& lane : lanes_) {
+                if (lane.empty()) continue;
+                batch.push_back(std::move(lane.front()));
+                lane.pop_front();
+                // By value: push_back below may reallocate batch
+                const JobKind kind = batch.front().request.kind;
+                const bool continueToPrint = batch.front().continueToPrint;
+                if (isSmall(batch.front())) {
+                    while (batch.size() < owner_.config_.maxBatch && !lane.empty() &&
+                           lane.front().request.kind == kind &&
+                           lane.front().continueToPrint == continueToPrint &&
+                           isSmall(lane.front())) {
+                        batch.push_back(std::move(lane.front()));
+                        lane.pop_front();
+                    }
+                }
+                break;
+            }
+            depth_.fetch_sub(batch.size(), std::memory_order_relaxed);
+            return batch;
+        }
+
+        void run() {
+            for (;;) {
+                std::vector<Job> batch;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    notEmpty_.wait(lock, [this] { return depth() > 0 || closing_; });
+                    if (depth() == 0 && closing_) return;
+                    batch = takeBatch();
+                }
+                notFull_.notify_all();
+
+                const auto busyStart = Clock::now();
+                if (owner_.config_.batchSetup.count() > 0) {
+                    std::this_thread::sleep_for(owner_.config_.batchSetup);
+                }
+
+                std::vector<std::chrono::microseconds> latencies;
+                latencies.reserve(batch.size());
+                for (auto& job : batch) {
+                    execute(job);
+                    latencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+                        Clock::now() - job.enqueued));
+                }
+                const auto busy = std::chrono::duration_cast<std::chrono::microseconds>(
+                    Clock::now() - busyStart);
+
+                std::lock_guard<std::mutex> lock(mutex_);
+                stats_.batches++;
+                stats_.busyTime += busy;
+                for (auto latency : latencies) {
+                    stats_.jobsCompleted++;
+                    stats_.totalLatency += latency;
+                    if (latency > stats_.maxLatency) stats_.maxLatency = latency;
+                }
+            }
+        }
+
+        void execute(Job& job) {
+            try {
+                const JobRequest& req = job.request;
+                switch (req.kind) {
+                case JobKind::Print:
+                    for (int i = 0; i < req.copies; ++i) printer->print(req.document);
+                    break;
+                case JobKind::Scan: {
+                    std::string scanned = scanner->scan();
+                    if (job.continueToPrint) {
+                        // Hand the scanned content to the print stage; the
+                        // promise travels with it and completes there. Route
+                        // first: if that throws, the promise is still ours.
+                        Device& printStage = owner_.route(JobKind::Print);
+                        Job next;
+                        next.request = req;
+                        next.request.kind = JobKind::Print;
+                        next.request.document = std::move(scanned);
+                        next.done = std::move(job.done);
+                        printStage.push(std::move(next), /*bypassBound=*/true);
+                        return;
+                    }
+                    break;
+                }
+                case JobKind::Fax:
+                    faxer->fax(req.document);
+                    break;
+                case JobKind::Copy:
+                    copier->copy(req.copies);
+                    break;
+                case JobKind::ScanToPrint:
+                    break;  // Split into Scan + Print at submit time
+                }
+                job.done.set_value();
+            } catch (...) {
+                job.done.set_exception(std::current_exception());
+            }
+            owner_.jobFinished();
+        }
+
+        JobScheduler& owner_;
+        mutable std::mutex mutex_;
+        std::condition_variable notEmpty_;
+        std::condition_variable notFull_;
+        std::array<std::deque<Job>, kPriorityLanes> lanes_;
+        std::atomic<std::size_t> depth_{0};
+        bool closing_ = false;
+        DeviceStats stats_;
+        std::jthread worker_;
+    };
+
+    static std::size_t capabilityIndex(JobKind kind) {
+        switch (kind) {
+        case JobKind::Print: return 0;
+        case JobKind::Scan:
+        case JobKind::ScanToPrint: return 1;
+        case JobKind::Fax: return 2;
+        case JobKind::Copy: return 3;
+        }
+        return 0;
+    }
+
+    // Least queue depth wins; the rotating start spreads ties across devices
+    Device& route(JobKind kind) {
+        const auto& candidates = routes_[capabilityIndex(kind)];
+        if (candidates.empty()) {
+            throw std::runtime_error("JobScheduler: no device supports this job");
+        }
+        const std::size_t start = nextRoute_.fetch_add(1, std::memory_order_relaxed);
+        Device* best = nullptr;
+        for (std::size_t i = 0; i < candidates.size(); ++i) {
+            Device* candidate = candidates[(start + i) % candidates.size()];
+            if (!best || candidate->depth() < best->depth()) best = candidate;
+            if (best->depth() == 0) break;
+        }
+        return *best;
+    }
+
+    void jobFinished() {
+        if (outstanding_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(idleMutex_);
+            idle_.notify_all();
+        }
+    }
+
+    SchedulerConfig config_;
+    std::vector<std::unique_ptr<Device>> devices_;
+    std::array<std::vector<Device*>, 4> routes_;  // Indexed by capability bit
+    std::atomic<std::size_t> nextRoute_{0};
+    std::atomic<std::size_t> outstanding_{0};
+    std::atomic<bool> closed_{false};
+    std::mutex idleMutex_;
+    std::condition_variable idle_;
+};
+
+} // namespace isp_sched
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// =============================================================================
+// dual_path — one function, a compile-time evaluator and a runtime kernel
+// =============================================================================
+// std::is_constant_evaluated() lets a constexpr function pick a different
+// algorithm when it runs at compile time. dual_path packages that choice:
+//
+//   inline constexpr dual::dual_path factorial{
+//       factorial_eval{},                                  // compile time
+//       dual::table_kernel<factorial_eval, dual::range<0u, 20u>>{}};  // runtime
+//
+//   static_assert(factorial(10) == 3628800);  // evaluator, at compile time
+//   factorial(n);                             // O(1) table lookup at runtime
+//
+// The evaluator is the specification. The runtime kernel can be a table the
+// evaluator fills at compile time (table_kernel), a cache (memo_kernel), or
+// any hand-written code such as a SIMD routine.
+
+namespace dual {
+
+template <typename Eval, typename Kernel> class dual_path {
+public:
+  constexpr dual_path(Eval eval, Kernel kernel)
+      : eval_(std::move(eval)), kernel_(std::move(kernel)) {}
+
+  template <typename... Args>
+    requires std::is_invocable_v<const Eval &, Args...>
+  constexpr auto operator()(Args... args) const {
+    if (std::is_constant_evaluated())
+      return std::invoke(eval_, args...);
+    else
+      return std::invoke(kernel_, args...);
+  }
+
+  // Direct access to each path, e.g. to test that they agree
+  constexpr const Eval &evaluator() const noexcept { return eval_; }
+  constexpr const Kernel &kernel() const noexcept { return kernel_; }
+
+private:
+  [[no_unique_address]] Eval eval_;
+  [[no_unique_address]] Kernel kernel_;
+};
+
+// Closed interval of one argument covered by a table
+template <auto Lo, auto Hi> struct range {
+  static_assert(Lo <= Hi);
+  using value_type = decltype(Lo);
+  static constexpr value_type lo = Lo;
+  static constexpr value_type hi = Hi;
+  static constexpr std::size_t extent = static_cast<std::size_t>(Hi - Lo) + 1;
+
+  template <typename T> static constexpr bool contains(T v) noexcept {
+    return std::cmp_greater_equal(v, Lo) && std::cmp_less_equal(v, Hi);
+  }
+};
+
+// Precomputes Eval over the cartesian product of Ranges at compile time.
+// Arguments inside the table are one load; anything else falls back to Eval.
+template <typename Eval, typename... Ranges> class table_kernel {
+public:
+  using result_type = std::invoke_result_t<Eval, typename Ranges::value_type...>;
+  static constexpr std::size_t size = (Ranges::extent * ...);
+
+  template <typename... Args>
+    requires(sizeof...(Args) == sizeof...(Ranges))
+  result_type operator()(Args... args) const {
+    if ((Ranges::contains(args) && ...))
+      return table[flat_index(args...)];
+    return Eval{}(static_cast<typename Ranges::value_type>(args)...);
+  }
+
+  static constexpr bool covers(auto... args) noexcept {
+    return (Ranges::contains(args) && ...);
+  }
+
+private:
+  // Row-major index; the last argument varies fastest
+  template <typename... Args> static constexpr std::size_t flat_index(Args... args) {
+    std::size_t index = 0;
+    ((index = index * Ranges::extent +
+              static_cast<std::size_t>(
+                  static_cast<typename Ranges::value_type>(args) - Ranges::lo)),
+     ...);
+    return index;
+  }
+
+  // Inverse of flat_index: the arguments for table slot `index`
+  static constexpr std::tuple<typename Ranges::value_type...> arguments(std::size_t index) {
+    std::tuple<typename Ranges::value_type...> args{};
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      constexpr std::size_t count = sizeof...(Ranges);
+      using RangeTuple = std::tuple<Ranges...>;
+      // Walk from the last (fastest) dimension to the first
+      (
+          [&] {
+            constexpr std::size_t dim = count - 1 - Is;
+            using R = std::tuple_element_t<dim, RangeTuple>;
+            std::get<dim>(args) = static_cast<typename R::value_type>(
+                R::lo + static_cast<typename R::value_type>(index % R::extent));
+            index /= R::extent;
+          }(),
+          ...);
+    }(std::index_sequence_for<Ranges...>{});
+    return args;
+  }
+
+  static constexpr std::array<result_type, size> table = [] {
+    std::array<result_type, size> values{};
+    for (std::size_t i = 0; i < size; ++i)
+      values[i] = std::apply(Eval{}, arguments(i));
+    return values;
+  }();
+};
+
+// Runtime kernel that caches results; for large or sparse domains where a
+// full table would be too big. Thread-safe.
+template <typename Eval> class memo_kernel {
+public:
+  template <typename... Args> auto operator()(Args... args) const {
+    using Result = std::invoke_result_t<Eval, Args...>;
+    static std::mutex mutex;
+    static std::map<std::tuple<Args...>, Result> cache;
+    const std::tuple<Args...> key{args...};
+    {
+      std::lock_guard lock(mutex);
+      if (auto it = cache.find(key); it != cache.end())
+        return it->second;
+    }
+    Result result = Eval{}(args...);
+    std::lock_guard lock(mutex);
+    cache.emplace(key, result);
+    return result;
+  }
+};
+
+// -----------------------------------------------------------------------------
+// Ready-made dual-path functions (64-bit results; tables cover every input
+// whose result fits)
+// -----------------------------------------------------------------------------
+
+struct factorial_eval {
+  constexpr std::uint64_t operator()(unsigned n) const {
+    std::uint64_t result = 1;
+    for (unsigned i = 2; i <= n; ++i)
+      result *= i;
+    return result;
+  }
+};
+
+struct fibonacci_eval {
+  constexpr std::uint64_t operator()(unsigned n) const {
+    std::uint64_t a = 0, b = 1;
+    for (unsigned i = 0; i < n; ++i)
+      a = std::exchange(b, a + b);
+    return a;
+  }
+};
+
+// Exponentiation by squaring; wraps like unsigned arithmetic on overflow
+struct power_eval {
+  constexpr std::int64_t operator()(int base, unsigned exp) const {
+    std::uint64_t result = 1;
+    auto b = static_cast<std::uint64_t>(static_cast<std::int64_t>(base));
+    for (; exp != 0; exp >>= 1) {
+      if (exp & 1u)
+        result *= b;
+      b *= b;
+    }
+    return static_cast<std::int64_t>(result);
+  }
+};
+
+inline constexpr dual_path factorial{
+    factorial_eval{}, table_kernel<factorial_eval, range<0u, 20u>>{}};
+
+inline constexpr dual_path fibonacci{
+    fibonacci_eval{}, table_kernel<fibonacci_eval, range<0u, 93u>>{}};
+
+// |base| <= 10 with exp <= 18 never overflows
+inline constexpr dual_path power{
+    power_eval{}, table_kernel<power_eval, range<-10, 10>, range<0u, 18u>>{}};
+
+} // namespace dual
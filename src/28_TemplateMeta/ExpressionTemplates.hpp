@@ -0,0 +1,275 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// =============================================================================
+// Expression templates — lazy, fused vector arithmetic
+// =============================================================================
+// `a + b * c - d` on etl::vec values does not compute anything. Each operator
+// returns a small node type (binary_expr<minus, binary_expr<plus, ...>, ...>)
+// that stores its operands. Assigning the tree to a vec (or reducing it) runs
+// ONE loop in which every element is evaluated through the whole tree:
+//
+//   for i: out[i] = a[i] + b[i] * c[i] - d[i];   // no temporaries
+//
+// Since the node types are fully known at compile time, the loop body inlines
+// to plain arithmetic and the compiler can vectorise it.
+
+namespace etl {
+
+template <typename T> class vec;
+
+// Marker base for every node type
+struct expr_tag {};
+
+template <typename E>
+concept Expr = std::derived_from<std::remove_cvref_t<E>, expr_tag>;
+
+namespace detail {
+
+// Vectors are held by reference: like any view, an expression must not
+// outlive the vectors it reads. Scalars and inner nodes are held by value.
+template <typename E>
+using stored_t =
+    std::conditional_t<requires { typename E::is_vec; }, const E &, E>;
+
+inline constexpr std::size_t broadcast_size = std::numeric_limits<std::size_t>::max();
+
+} // namespace detail
+
+// A scalar broadcast to every index
+template <typename T> struct scalar : expr_tag {
+  using value_type = T;
+  T value;
+  explicit constexpr scalar(T v) : value(v) {}
+  constexpr T operator[](std::size_t) const noexcept { return value; }
+  // Matches any length
+  static constexpr std::size_t size() noexcept { return detail::broadcast_size; }
+};
+
+template <typename Op, typename L, typename R> class binary_expr : public expr_tag {
+public:
+  using value_type =
+      decltype(Op{}(std::declval<L>()[0], std::declval<R>()[0]));
+
+  binary_expr(const L &lhs, const R &rhs) : lhs_(lhs), rhs_(rhs) {
+    if (lhs_.size() != rhs_.size() && lhs_.size() != detail::broadcast_size &&
+        rhs_.size() != detail::broadcast_size)
+      throw std::length_error("etl: operand sizes differ");
+  }
+
+  value_type operator[](std::size_t i) const { return Op{}(lhs_[i], rhs_[i]); }
+  std::size_t size() const noexcept { return std::min(lhs_.size(), rhs_.size()); }
+
+private:
+  detail::stored_t<L> lhs_;
+  detail::stored_t<R> rhs_;
+};
+
+template <typename Op, typename E> class unary_expr : public expr_tag {
+public:
+  using value_type = decltype(Op{}(std::declval<E>()[0]));
+
+  explicit unary_expr(const E &e) : e_(e) {}
+  value_type operator[](std::size_t i) const { return Op{}(e_[i]); }
+  std::size_t size() const noexcept { return e_.size(); }
+
+private:
+  detail::stored_t<E> e_;
+};
+
+// Owning vector; assignment from an expression is the single fused loop
+template <typename T> class vec : public expr_tag {
+public:
+  using value_type = T;
+  using is_vec = void;
+
+  vec() = default;
+  explicit vec(std::size_t n, T value = T{}) : data_(n, value) {}
+  vec(std::initializer_list<T> values) : data_(values) {}
+
+  template <Expr E> vec(const E &e) : data_(e.size()) { assign(e); }
+
+  template <Expr E> vec &operator=(const E &e) {
+    // Element i of the result depends only on element i of the operands, so
+    // assigning into an operand (a = a + b) is safe
+    if (data_.size() != e.size())
+      data_.resize(e.size());
+    assign(e);
+    return *this;
+  }
+
+  template <Expr E> vec &operator+=(const E &e) { return *this = *this + e; }
+  template <Expr E> vec &operator-=(const E &e) { return *this = *this - e; }
+  template <Expr E> vec &operator*=(const E &e) { return *this = *this * e; }
+
+  T operator[](std::size_t i) const noexcept { return data_[i]; }
+  T &operator[](std::size_t i) noexcept { return data_[i]; }
+  std::size_t size() const noexcept { return data_.size(); }
+  T *data() noexcept { return data_.data(); }
+  const T *data() const noexcept { return data_.data(); }
+  auto begin() noexcept { return data_.begin(); }
+  auto end() noexcept { return data_.end(); }
+  auto begin() const noexcept { return data_.begin(); }
+  auto end() const noexcept { return data_.end(); }
+
+private:
+  template <typename E> void assign(const E &e) {
+    T *out = data_.data();
+    const std::size_t n = data_.size();
+    for (std::size_t i = 0; i < n; ++i)
+      out[i] = static_cast<T>(e[i]);
+  }
+
+  std::vector<T> data_;
+};
+
+// -----------------------------------------------------------------------------
+// Operators: each builds one node; nothing is evaluated here
+// -----------------------------------------------------------------------------
+
+namespace detail {
+
+template <typename E> decltype(auto) as_expr(const E &e) {
+  if constexpr (Expr<E>)
+    return (e); // const E&
+  else
+    return scalar<E>(e);
+}
+
+template <typename A, typename B>
+concept Operands = (Expr<A> || Expr<B>) &&
+                   (Expr<A> || std::is_arithmetic_v<A>) &&
+                   (Expr<B> || std::is_arithmetic_v<B>);
+
+template <typename Op, typename A, typename B> auto make_binary(const A &a, const B &b) {
+  using L = std::remove_cvref_t<decltype(as_expr(a))>;
+  using R = std::remove_cvref_t<decltype(as_expr(b))>;
+  return binary_expr<Op, L, R>(as_expr(a), as_expr(b));
+}
+
+} // namespace detail
+
+template <typename A, typename B>
+  requires detail::Operands<A, B>
+auto operator+(const A &a, const B &b) {
+  return detail::make_binary<std::plus<>>(a, b);
+}
+
+template <typename A, typename B>
+  requires detail::Operands<A, B>
+auto operator-(const A &a, const B &b) {
+  return detail::make_binary<std::minus<>>(a, b);
+}
+
+template <typename A, typename B>
+  requires detail::Operands<A, B>
+auto operator*(const A &a, const B &b) {
+  return detail::make_binary<std::multiplies<>>(a, b);
+}
+
+template <typename A, typename B>
+  requires detail::Operands<A, B>
+auto operator/(const A &a, const B &b) {
+  return detail::make_binary<std::divides<>>(a, b);
+}
+
+template <typename A, typename B>
+  requires detail::Operands<A, B>
+auto operator<(const A &a, const B &b) {
+  return detail::make_binary<std::less<>>(a, b);
+}
+
+template <typename A, typename B>
+  requires detail::Operands<A, B>
+auto operator>(const A &a, const B &b) {
+  return detail::make_binary<std::greater<>>(a, b);
+}
+
+// Element-wise logical operators (no short circuit)
+template <typename A, typename B>
+  requires detail::Operands<A, B>
+auto operator&&(const A &a, const B &b) {
+  return detail::make_binary<std::logical_and<>>(a, b);
+}
+
+template <typename A, typename B>
+  requires detail::Operands<A, B>
+auto operator||(const A &a, const B &b) {
+  return detail::make_binary<std::logical_or<>>(a, b);
+}
+
+template <Expr E> auto operator-(const E &e) {
+  return unary_expr<std::negate<>, E>(e);
+}
+
+template <Expr E> auto operator!(const E &e) {
+  return unary_expr<std::logical_not<>, E>(e);
+}
+
+// -----------------------------------------------------------------------------
+// Reductions: one pass, Lanes independent accumulators combined with folds
+// -----------------------------------------------------------------------------
+// A single accumulator serialises the loop on its add latency (and forbids
+// reassociating floating-point adds). Lanes partial results, updated by a
+// fold over an index_sequence, give the CPU independent chains. The lanes
+// start from the first Lanes elements, so init is applied exactly once and
+// need not be an identity of op.
+
+template <std::size_t Lanes = 4, Expr E, typename T, typename Op>
+T reduce(const E &e, T init, Op op) {
+  const std::size_t n = e.size();
+  if (n < Lanes) {
+    for (std::size_t i = 0; i < n; ++i)
+      init = op(init, static_cast<T>(e[i]));
+    return init;
+  }
+  return [&]<std::size_t... Ls>(std::index_sequence<Ls...>) {
+    T acc[Lanes] = {static_cast<T>(e[Ls])...};
+    std::size_t i = Lanes;
+    for (; i + Lanes <= n; i += Lanes)
+      ((acc[Ls] = op(acc[Ls], static_cast<T>(e[i + Ls]))), ...);
+    for (; i < n; ++i)
+      acc[0] = op(acc[0], static_cast<T>(e[i]));
+    T result = init;
+    ((result = op(result, acc[Ls])), ...);
+    return result;
+  }(std::make_index_sequence<Lanes>{});
+}
+
+template <Expr E> auto sum(const E &e) {
+  using T = typename E::value_type;
+  return reduce(e, T{}, std::plus<>{});
+}
+
+template <Expr E> auto product(const E &e) {
+  using T = typename E::value_type;
+  return reduce(e, T{1}, std::multiplies<>{});
+}
+
+template <Expr E> auto max(const E &e) {
+  using T = typename E::value_type;
+  return reduce(e, std::numeric_limits<T>::lowest(),
+                [](T a, T b) { return a < b ? b : a; });
+}
+
+// Counting instead of early exit keeps the loop branch-free
+template <Expr E> std::size_t count(const E &e) {
+  return reduce(e, std::size_t{0}, std::plus<>{});
+}
+
+template <Expr E> bool all_of(const E &e) { return count(e) == e.size(); }
+template <Expr E> bool any_of(const E &e) { return count(e) != 0; }
+
+template <Expr A, Expr B> auto dot(const A &a, const B &b) { return sum(a * b); }
+
+} // namespace etl
@@ -0,0 +1,499 @@
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Ordering the addresses of two members of one object, seen as const void*,
+// is unspecified by the standard. GCC evaluates it in a constant expression
+// anyway; Clang and MSVC reject it. Elsewhere the memcpy fast path is off.
+#if defined(__GNUC__) && !defined(__clang__)
+#define REFLECT_HAS_CONSTEXPR_MEMBER_ORDER 1
+#endif
+
+// =============================================================================
+// Reflection-lite: compile-time field descriptors
+// =============================================================================
+// A record lists its fields once, as member pointers plus names passed as
+// non-type template parameters:
+//
+//   struct Trade {
+//     std::uint64_t timestamp;
+//     double price;
+//     using fields = reflect::field_list<
+//         reflect::field<&Trade::timestamp, "timestamp">,
+//         reflect::field<&Trade::price, "price">>;
+//   };
+//
+// (or specialise reflect::descriptor<T> for types you cannot edit). From that
+// list the templates below generate a binary encoder/decoder, hashing,
+// comparison, text printing/reading and a structure-of-arrays splitter.
+//
+// Wire format: fields packed in listed order, host byte order, no padding;
+// std::string is a uint32 length followed by the bytes; described members
+// are encoded recursively. When a record's memory image already IS that
+// format (see memcpy_layout) encoding is a single memcpy.
+
+namespace reflect {
+
+// String literal usable as a template argument
+template <std::size_t N> struct fixed_string {
+  char chars[N]{};
+  constexpr fixed_string(const char (&s)[N]) {
+    for (std::size_t i = 0; i < N; ++i)
+      chars[i] = s[i];
+  }
+  constexpr std::string_view view() const { return {chars, N - 1}; }
+};
+
+template <typename> struct member_traits;
+template <typename C, typename M> struct member_traits<M C::*> {
+  using class_type = C;
+  using value_type = M;
+};
+
+template <auto Member, fixed_string Name> struct field {
+  using class_type = typename member_traits<decltype(Member)>::class_type;
+  using value_type = typename member_traits<decltype(Member)>::value_type;
+  static constexpr auto pointer = Member;
+  static constexpr std::string_view name = Name.view();
+
+  static constexpr const value_type &get(const class_type &obj) noexcept {
+    return obj.*Member;
+  }
+  static constexpr value_type &get(class_type &obj) noexcept {
+    return obj.*Member;
+  }
+};
+
+template <typename... Fields> struct field_list {
+  static constexpr std::size_t size = sizeof...(Fields);
+  using tuple = std::tuple<Fields...>;
+};
+
+// Primary template is empty: only described types have `fields`
+template <typename T> struct descriptor {};
+
+template <typename T>
+  requires requires { typename T::fields; }
+struct descriptor<T> {
+  using fields = typename T::fields;
+};
+
+template <typename T>
+concept Described = requires { typename descriptor<T>::fields; };
+
+template <Described T> using fields_of = typename descriptor<T>::fields;
+
+template <Described T>
+inline constexpr std::size_t field_count = fields_of<T>::size;
+
+template <Described T, std::size_t I>
+using field_at = std::tuple_element_t<I, typename fields_of<T>::tuple>;
+
+template <Described T, std::size_t I>
+using field_type = typename field_at<T, I>::value_type;
+
+// Calls f(Fields{}...) with one empty descriptor object per field
+template <Described T, typename F> constexpr decltype(auto) apply_fields(F &&f) {
+  return [&]<typename... Fs>(field_list<Fs...>) -> decltype(auto) {
+    return std::forward<F>(f)(Fs{}...);
+  }(fields_of<T>{});
+}
+
+template <Described T> constexpr auto field_names() {
+  return apply_fields<T>([](auto... fs) {
+    return std::array<std::string_view, sizeof...(fs)>{fs.name...};
+  });
+}
+
+// -----------------------------------------------------------------------------
+// Layout analysis
+// -----------------------------------------------------------------------------
+
+namespace detail {
+
+template <typename V>
+inline constexpr bool is_raw_value = std::is_trivially_copyable_v<V> &&
+                                     !std::is_pointer_v<V> &&
+                                     !std::is_member_pointer_v<V> &&
+                                     !Described<V>;
+
+template <typename V> constexpr bool is_fixed_size();
+
+template <typename V> constexpr std::size_t fixed_size() {
+  if constexpr (Described<V>) {
+    return apply_fields<V>([](auto... fs) {
+      return (std::size_t{0} + ... +
+              fixed_size<typename decltype(fs)::value_type>());
+    });
+  } else {
+    return sizeof(V);
+  }
+}
+
+template <typename V> constexpr bool is_fixed_size() {
+  if constexpr (Described<V>) {
+    return apply_fields<V>([](auto... fs) {
+      return (true && ... && is_fixed_size<typename decltype(fs)::value_type>());
+    });
+  } else {
+    return is_raw_value<V>;
+  }
+}
+
+// Fields listed in declaration order. Without a compiler that can order
+// member addresses at compile time this answers false, which only costs the
+// memcpy shortcut: the per-field encoding produces the same bytes.
+template <typename T, typename... Fs> constexpr bool listed_in_memory_order() {
+  if constexpr (sizeof...(Fs) < 2) {
+    return true;
+  } else {
+#ifndef REFLECT_HAS_CONSTEXPR_MEMBER_ORDER
+    return false;
+#else
+    T obj{};
+    const void *addresses[] = {static_cast<const void *>(&Fs::get(obj))...};
+    for (std::size_t i = 1; i < sizeof...(Fs); ++i) {
+      if (!(addresses[i - 1] < addresses[i]))
+        return false;
+    }
+    return true;
+#endif
+  }
+}
+
+template <typename V> constexpr bool memcpy_layout_impl();
+
+template <typename V> constexpr bool member_is_bitwise() {
+  if constexpr (Described<V>)
+    return memcpy_layout_impl<V>();
+  else
+    return is_raw_value<V>;
+}
+
+template <typename T> constexpr bool memcpy_layout_impl() {
+  if constexpr (!std::is_trivially_copyable_v<T> ||
+                !std::is_default_constructible_v<T>) {
+    return false;
+  } else {
+    return apply_fields<T>([](auto... fs) {
+      using Fs = std::tuple<decltype(fs)...>;
+      // Every member listed, no padding: the listed sizes add up to sizeof(T)
+      constexpr bool covers =
+          (std::size_t{0} + ... + sizeof(typename decltype(fs)::value_type)) ==
+          sizeof(T);
+      if constexpr (!covers ||
+                    !(member_is_bitwise<typename decltype(fs)::value_type>() &&
+                      ...)) {
+        return false;
+      } else {
+        return []<typename... Ts>(std::tuple<Ts...> *) {
+          return listed_in_memory_order<T, Ts...>();
+        }(static_cast<Fs *>(nullptr));
+      }
+    });
+  }
+}
+
+} // namespace detail
+
+// Every field has a fixed encoded size (no strings anywhere inside)
+template <Described T>
+inline constexpr bool fixed_size = detail::is_fixed_size<T>();
+
+template <Described T>
+  requires fixed_size<T>
+inline constexpr std::size_t wire_size = detail::fixed_size<T>();
+
+// The object's bytes are exactly its wire encoding: trivially copyable, no
+// padding, every member listed, listed in declaration order. Always false
+// without REFLECT_HAS_CONSTEXPR_MEMBER_ORDER (see listed_in_memory_order).
+template <Described T>
+inline constexpr bool memcpy_layout = detail::memcpy_layout_impl<T>();
+
+// Byte offset of each field in the encoding. For memcpy_layout types these
+// are also the member offsets, which member pointers cannot yield directly in
+// a constant expression.
+template <Described T>
+  requires fixed_size<T>
+constexpr std::array<std::size_t, field_count<T>> field_offsets() {
+  std::array<std::size_t, field_count<T>> offsets{};
+  std::array<std::size_t, field_count<T>> sizes =
+      apply_fields<T>([](auto... fs) {
+        return std::array<std::size_t, sizeof...(fs)>{
+            detail::fixed_size<typename decltype(fs)::value_type>()...};
+      });
+  for (std::size_t i = 1; i < offsets.size(); ++i)
+    offsets[i] = offsets[i - 1] + sizes[i - 1];
+  return offsets;
+}
+
+// -----------------------------------------------------------------------------
+// Binary encoder / decoder
+// -----------------------------------------------------------------------------
+
+namespace detail {
+
+inline void append_bytes(std::vector<std::byte> &out, const void *src,
+                         std::size_t n) {
+  const auto *bytes = static_cast<const std::byte *>(src);
+  out.insert(out.end(), bytes, bytes + n);
+}
+
+struct Reader {
+  std::span<const std::byte> in;
+  std::size_t pos = 0;
+
+  void read(void *dst, std::size_t n) {
+    if (n > in.size() - pos)
+      throw std::out_of_range("reflect::decode: truncated input");
+    std::memcpy(dst, in.data() + pos, n);
+    pos += n;
+  }
+};
+
+template <typename V>
+void encode_value(const V &value, std::vector<std::byte> &out) {
+  if constexpr (Described<V>) {
+    if constexpr (memcpy_layout<V>) {
+      append_bytes(out, &value, sizeof(V));
+    } else {
+      apply_fields<V>(
+          [&](auto... fs) { (encode_value(fs.get(value), out), ...); });
+    }
+  } else if constexpr (std::is_same_v<V, std::string>) {
+    if (value.size() > UINT32_MAX)
+      throw std::length_error("reflect::encode: string too long");
+    const auto length = static_cast<std::uint32_t>(value.size());
+    append_bytes(out, &length, sizeof(length));
+    append_bytes(out, value.data(), value.size());
+  } else {
+    static_assert(is_raw_value<V>, "field type has no binary encoding");
+    append_bytes(out, &value, sizeof(V));
+  }
+}
+
+template <typename V> void decode_value(Reader &reader, V &value) {
+  if constexpr (Described<V>) {
+    if constexpr (memcpy_layout<V>) {
+      reader.read(&value, sizeof(V));
+    } else {
+      apply_fields<V>([&](auto... fs) { (decode_value(reader, fs.get(value)), ...); });
+    }
+  } else if constexpr (std::is_same_v<V, std::string>) {
+    std::uint32_t length = 0;
+    reader.read(&length, sizeof(length));
+    if (length > reader.in.size() - reader.pos)
+      throw std::out_of_range("reflect::decode: truncated input");
+    value.assign(reinterpret_cast<const char *>(reader.in.data() + reader.pos),
+                 length);
+    reader.pos += length;
+  } else {
+    static_assert(is_raw_value<V>, "field type has no binary encoding");
+    reader.read(&value, sizeof(V));
+  }
+}
+
+} // namespace detail
+
+// Appends the encoding of `value` to `out`
+template <Described T>
+void encode(const T &value, std::vector<std::byte> &out) {
+  detail::encode_value(value, out);
+}
+
+// Appends all records; one memcpy for the whole span when memcpy_layout<T>
+template <Described T>
+void encode_all(std::span<const T> values, std::vector<std::byte> &out) {
+  if constexpr (memcpy_layout<T>) {
+    detail::append_bytes(out, values.data(), values.size_bytes());
+  } else {
+    if constexpr (fixed_size<T>)
+      out.reserve(out.size() + values.size() * wire_size<T>);
+    for (const T &value : values)
+      detail::encode_value(value, out);
+  }
+}
+
+// Decodes one record from the front of `in`; returns the bytes consumed.
+// Throws std::out_of_range on truncated input.
+template <Described T>
+std::size_t decode(std::span<const std::byte> in, T &value) {
+  detail::Reader reader{in};
+  detail::decode_value(reader, value);
+  return reader.pos;
+}
+
+// Decodes records until `in` is exhausted
+template <Described T> std::vector<T> decode_all(std::span<const std::byte> in) {
+  std::vector<T> values;
+  if constexpr (memcpy_layout<T>) {
+    if (in.size() % sizeof(T) != 0)
+      throw std::out_of_range("reflect::decode: truncated input");
+    values.resize(in.size() / sizeof(T));
+    std::memcpy(values.data(), in.data(), in.size());
+  } else {
+    detail::Reader reader{in};
+    while (reader.pos < in.size())
+      detail::decode_value(reader, values.emplace_back());
+  }
+  return values;
+}
+
+// -----------------------------------------------------------------------------
+// Hashing and comparison (member-wise, so consistent with each other)
+// -----------------------------------------------------------------------------
+
+template <typename V> std::size_t hash_value(const V &value) {
+  if constexpr (Described<V>) {
+    return apply_fields<V>([&](auto... fs) {
+      std::size_t seed = 0;
+      ((seed ^= hash_value(fs.get(value)) + 0x9e3779b97f4a7c15ULL +
+                (seed << 6) + (seed >> 2)),
+       ...);
+      return seed;
+    });
+  } else if constexpr (std::has_unique_object_representations_v<V>) {
+    // FNV-1a over the bytes: equal values have equal bytes
+    std::uint64_t h = 14695981039346656037ULL;
+    const auto *bytes = reinterpret_cast<const unsigned char *>(&value);
+    for (std::size_t i = 0; i < sizeof(V); ++i)
+      h = (h ^ bytes[i]) * 1099511628211ULL;
+    return static_cast<std::size_t>(h);
+  } else {
+    return std::hash<V>{}(value);
+  }
+}
+
+// Drop-in hasher for unordered containers
+struct field_hash {
+  template <Described T> std::size_t operator()(const T &value) const {
+    return hash_value(value);
+  }
+};
+
+template <Described T> constexpr bool fields_equal(const T &a, const T &b);
+template <Described T> constexpr auto fields_compare(const T &a, const T &b);
+
+namespace detail {
+
+template <typename V> constexpr bool value_equal(const V &a, const V &b) {
+  if constexpr (Described<V>)
+    return fields_equal(a, b);
+  else
+    return a == b;
+}
+
+template <typename V> constexpr auto value_compare(const V &a, const V &b) {
+  if constexpr (Described<V>)
+    return fields_compare(a, b);
+  else
+    return std::compare_three_way{}(a, b);
+}
+
+} // namespace detail
+
+template <Described T> constexpr bool fields_equal(const T &a, const T &b) {
+  return apply_fields<T>([&](auto... fs) {
+    return (detail::value_equal(fs.get(a), fs.get(b)) && ...);
+  });
+}
+
+// Lexicographic three-way comparison in field order
+template <Described T> constexpr auto fields_compare(const T &a, const T &b) {
+  return apply_fields<T>([&](auto... fs) {
+    using Result = std::common_comparison_category_t<decltype(detail::value_compare(
+        fs.get(a), fs.get(b)))...>;
+    Result result = Result::equivalent;
+    ((result = detail::value_compare(fs.get(a), fs.get(b)), result != 0) || ...);
+    return result;
+  });
+}
+
+// -----------------------------------------------------------------------------
+// Text printing / reading - replaces per-record print() and input()
+// -----------------------------------------------------------------------------
+
+template <typename V> void print_value(std::ostream &os, const V &value);
+
+// "{timestamp=1, price=101.5}"
+template <Described T> void print_fields(std::ostream &os, const T &value) {
+  apply_fields<T>([&](auto... fs) {
+    os << "{";
+    std::size_t i = 0;
+    ((os << (i++ == 0 ? "" : ", ") << fs.name << "=", print_value(os, fs.get(value))), ...);
+    os << "}";
+  });
+}
+
+template <typename V> void print_value(std::ostream &os, const V &value) {
+  if constexpr (Described<V>)
+    print_fields(os, value);
+  else
+    os << value;
+}
+
+// Reads whitespace-separated values in field order (strings are one word)
+template <Described T> std::istream &read_fields(std::istream &is, T &value) {
+  apply_fields<T>([&](auto... fs) {
+    (
+        [&](auto &member) {
+          if constexpr (Described<std::remove_cvref_t<decltype(member)>>)
+            read_fields(is, member);
+          else
+            is >> member;
+        }(fs.get(value)),
+        ...);
+  });
+  return is;
+}
+
+// -----------------------------------------------------------------------------
+// Structure-of-arrays splitter
+// -----------------------------------------------------------------------------
+
+namespace detail {
+template <typename List> struct columns_of;
+template <typename... Fs> struct columns_of<field_list<Fs...>> {
+  using type = std::tuple<std::vector<typename Fs::value_type>...>;
+};
+} // namespace detail
+
+// One contiguous vector per field, e.g. every price in one std::vector<double>
+template <Described T>
+using columns = typename detail::columns_of<fields_of<T>>::type;
+
+template <Described T> columns<T> split_columns(std::span<const T> rows) {
+  columns<T> cols;
+  [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    (std::get<Is>(cols).reserve(rows.size()), ...);
+    for (const T &row : rows)
+      (std::get<Is>(cols).push_back(field_at<T, Is>::get(row)), ...);
+  }(std::make_index_sequence<field_count<T>>{});
+  return cols;
+}
+
+template <Described T> std::vector<T> join_columns(const columns<T> &cols) {
+  std::vector<T> rows(std::get<0>(cols).size());
+  [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    for (std::size_t r = 0; r < rows.size(); ++r)
+      ((field_at<T, Is>::get(rows[r]) = std::get<Is>(cols)[r]), ...);
+  }(std::make_index_sequence<field_count<T>>{});
+  return rows;
+}
+
+} // namespace reflect
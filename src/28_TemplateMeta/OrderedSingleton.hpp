@@ -0,0 +1,315 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <iomanip>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+// =============================================================================
+// Explicitly ordered singletons
+// =============================================================================
+// A function-local static (`static Derived inst; return inst;`) checks its
+// guard variable on every call, and the construction order across translation
+// units is whatever the first calls happen to be. Here each singleton names
+// its dependencies in its base class:
+//
+//   class Database : public startup::OrderedSingleton<Database, Config, Logger>
+//
+// and a SingletonRegistry constructs them in dependency order at a point the
+// program chooses: eagerly in main(), in parallel on several threads, or
+// lazily on first use through get_or_init(). Once initialised, instance() is
+// a single pointer load. Each construction is timed, so slow initialisers
+// show up in report() instead of disappearing into "startup".
+
+namespace startup {
+
+struct InitMetrics {
+  std::string_view name;
+  std::chrono::nanoseconds duration{0};
+  std::size_t sequence = 0; // 0 = first singleton to finish
+  bool lazy = false;        // Constructed by get_or_init() rather than the registry
+};
+
+namespace detail {
+
+struct SingletonNode {
+  enum State : int { Uninitialized, Initializing, Ready };
+
+  std::string_view (*name)();
+  void (*create)();
+  void (*destroy)();
+  std::span<SingletonNode *const> (*dependencies)();
+
+  std::atomic<int> state{Uninitialized};
+  bool registering = false; // Cycle detection in SingletonRegistry::add
+  InitMetrics metrics{};
+};
+
+inline std::atomic<std::size_t> next_sequence{0};
+
+[[noreturn]] inline void throw_cycle(const SingletonNode &node) {
+  throw std::logic_error("startup::SingletonRegistry: dependency cycle through " +
+                         std::string(node.name()));
+}
+
+// The dependency chain ensure() is currently walking on this thread, one
+// frame per recursion level
+struct EnsurePath {
+  const SingletonNode *node;
+  const EnsurePath *parent;
+};
+
+// Constructs `node` once its dependencies are ready. Concurrent callers for
+// the same node wait for the winner; waits only follow dependency edges, so
+// they cannot deadlock. A cycle (reachable through get_or_init() without a
+// registry having checked it) throws std::logic_error instead of recursing.
+inline void ensure(SingletonNode &node, bool lazy, const EnsurePath *path = nullptr) {
+  if (node.state.load(std::memory_order_acquire) == SingletonNode::Ready)
+    return;
+  for (const EnsurePath *step = path; step; step = step->parent) {
+    if (step->node == &node)
+      throw_cycle(node);
+  }
+  const EnsurePath here{&node, path};
+  for (SingletonNode *dependency : node.dependencies())
+    ensure(*dependency, lazy, &here);
+
+  int expected = SingletonNode::Uninitialized;
+  while (!node.state.compare_exchange_weak(expected, SingletonNode::Initializing,
+                                           std::memory_order_acquire)) {
+    if (expected == SingletonNode::Ready)
+      return;
+    if (expected == SingletonNode::Initializing) {
+      node.state.wait(SingletonNode::Initializing, std::memory_order_acquire);
+      expected = SingletonNode::Uninitialized;
+    }
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  try {
+    node.create();
+  } catch (...) {
+    node.state.store(SingletonNode::Uninitialized, std::memory_order_release);
+    node.state.notify_all();
+    throw;
+  }
+  node.metrics.name = node.name();
+  node.metrics.duration = std::chrono::steady_clock::now() - start;
+  node.metrics.lazy = lazy;
+  node.metrics.sequence = next_sequence.fetch_add(1, std::memory_order_relaxed);
+  node.state.store(SingletonNode::Ready, std::memory_order_release);
+  node.state.notify_all();
+}
+
+template <typename T>
+concept HasSingletonName = requires {
+  { T::singleton_name } -> std::convertible_to<std::string_view>;
+};
+
+} // namespace detail
+
+// CRTP base. Derived needs a default constructor accessible to this base
+// (make it private and befriend OrderedSingleton<Derived, Deps...>).
+template <typename Derived, typename... Deps> class OrderedSingleton {
+public:
+  // Precondition: initialised (by a registry or get_or_init()). No guard
+  // branch: on x86 and AArch64 an acquire load is a plain load.
+  static Derived &instance() noexcept {
+    Derived *p = instance_.load(std::memory_order_acquire);
+    assert(p && "OrderedSingleton::instance() before initialisation");
+    return *p;
+  }
+
+  // Deferred path: constructs this singleton (and its dependencies) on first
+  // use. Safe to race from several threads.
+  static Derived &get_or_init() {
+    if (Derived *p = instance_.load(std::memory_order_acquire))
+      return *p;
+    detail::ensure(node_, true);
+    return *instance_.load(std::memory_order_acquire);
+  }
+
+  static bool initialized() noexcept {
+    return instance_.load(std::memory_order_acquire) != nullptr;
+  }
+
+  static constexpr detail::SingletonNode &node() noexcept { return node_; }
+
+protected:
+  OrderedSingleton() = default;
+  ~OrderedSingleton() = default;
+
+private:
+  OrderedSingleton(const OrderedSingleton &) = delete;
+  OrderedSingleton &operator=(const OrderedSingleton &) = delete;
+
+  static std::string_view name() {
+    if constexpr (detail::HasSingletonName<Derived>)
+      return Derived::singleton_name;
+    else
+      return typeid(Derived).name();
+  }
+
+  static void create() {
+    instance_.store(new Derived(), std::memory_order_release);
+  }
+
+  static void destroy() {
+    delete instance_.exchange(nullptr, std::memory_order_acq_rel);
+    node_.state.store(detail::SingletonNode::Uninitialized,
+                      std::memory_order_release);
+  }
+
+  static std::span<detail::SingletonNode *const> dependencies() {
+    static constexpr std::array<detail::SingletonNode *, sizeof...(Deps)>
+        deps{&Deps::node()...};
+    return deps;
+  }
+
+  // Both constant-initialised: no static-initialisation-order hazard
+  static constinit inline std::atomic<Derived *> instance_{nullptr};
+  static constinit inline detail::SingletonNode node_{&name, &create, &destroy,
+                                                      &dependencies};
+};
+
+// Owns the startup order. Not thread-safe while adding; init_all and
+// init_parallel may run while other threads call get_or_init().
+class SingletonRegistry {
+public:
+  SingletonRegistry() = default;
+  SingletonRegistry(const SingletonRegistry &) = delete;
+  SingletonRegistry &operator=(const SingletonRegistry &) = delete;
+  ~SingletonRegistry() { shutdown(); }
+
+  // Registers T after its dependencies (added implicitly). Throws
+  // std::logic_error on a dependency cycle.
+  template <typename T> SingletonRegistry &add() {
+    add_node(T::node());
+    return *this;
+  }
+
+  template <typename... Ts> SingletonRegistry &add_all() {
+    (add<Ts>(), ...);
+    return *this;
+  }
+
+  // Constructs every registered singleton on the calling thread
+  void init_all() {
+    for (detail::SingletonNode *node : nodes_)
+      detail::ensure(*node, false);
+  }
+
+  // Constructs independent singletons concurrently on `threads` threads;
+  // each node still waits for its own dependencies
+  void init_parallel(std::size_t threads) {
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::atomic_flag error_set;
+    {
+      std::vector<std::jthread> workers;
+      for (std::size_t t = 0; t < std::max<std::size_t>(threads, 1); ++t) {
+        workers.emplace_back([&] {
+          for (std::size_t i; (i = next.fetch_add(1)) < nodes_.size();) {
+            try {
+              detail::ensure(*nodes_[i], false);
+            } catch (...) {
+              if (!error_set.test_and_set())
+                error = std::current_exception();
+            }
+          }
+        });
+      }
+    }
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+  // Destroys the registered singletons in reverse construction order
+  void shutdown() {
+    std::vector<detail::SingletonNode *> ready;
+    for (detail::SingletonNode *node : nodes_) {
+      if (node->state.load(std::memory_order_acquire) ==
+          detail::SingletonNode::Ready)
+        ready.push_back(node);
+    }
+    std::sort(ready.begin(), ready.end(), [](auto *a, auto *b) {
+      return a->metrics.sequence > b->metrics.sequence;
+    });
+    for (detail::SingletonNode *node : ready)
+      node->destroy();
+  }
+
+  // Metrics of the constructed singletons, in construction order
+  std::vector<InitMetrics> metrics() const {
+    std::vector<InitMetrics> result;
+    for (const detail::SingletonNode *node : nodes_) {
+      if (node->state.load(std::memory_order_acquire) ==
+          detail::SingletonNode::Ready)
+        result.push_back(node->metrics);
+    }
+    std::sort(result.begin(), result.end(),
+              [](const auto &a, const auto &b) { return a.sequence < b.sequence; });
+    return result;
+  }
+
+  void report(std::ostream &os) const {
+    const auto all = metrics();
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    std::chrono::nanoseconds total{0};
+    for (const auto &m : all)
+      total += m.duration;
+    os << "  " << std::left << std::setw(14) << "singleton" << std::right
+       << std::setw(10) << "init ms" << std::setw(8) << "share"
+       << "  mode\n";
+    for (const auto &m : all) {
+      const double ms = std::chrono::duration<double, std::milli>(m.duration).count();
+      const double share =
+          total.count() ? 100.0 * static_cast<double>(m.duration.count()) /
+                              static_cast<double>(total.count())
+                        : 0.0;
+      os << "  " << std::left << std::setw(14) << m.name << std::right
+         << std::fixed << std::setprecision(2) << std::setw(10) << ms
+         << std::setprecision(0) << std::setw(7) << share << "%  "
+         << (m.lazy ? "lazy" : "eager") << "\n";
+    }
+    os.flags(flags);
+    os.precision(precision);
+  }
+
+  std::size_t size() const noexcept { return nodes_.size(); }
+
+private:
+  void add_node(detail::SingletonNode &node) {
+    if (std::find(nodes_.begin(), nodes_.end(), &node) != nodes_.end())
+      return;
+    if (node.registering)
+      detail::throw_cycle(node);
+    node.registering = true;
+    try {
+      for (detail::SingletonNode *dependency : node.dependencies())
+        add_node(*dependency);
+    } catch (...) {
+      node.registering = false;
+      throw;
+    }
+    node.registering = false;
+    nodes_.push_back(&node);
+  }
+
+  std::vector<detail::SingletonNode *> nodes_; // Topologically ordered
+};
+
+} // namespace startup
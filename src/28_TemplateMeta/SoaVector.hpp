@@ -0,0 +1,342 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// =============================================================================
+// soa_vector<Ts...> — structure of arrays driven by a type pack
+// =============================================================================
+// Stores each Ts in its own std::vector, so a loop over one or two columns
+// streams through contiguous memory of exactly those types. Rows are read and
+// written through proxy tuples of references:
+//
+//   soa_vector<float, float, int> particles;       // x, y, id
+//   particles.push_back(1.f, 2.f, 7);
+//   auto [x, y, id] = particles[0];                // float&, float&, int&
+//   for (float& x : particles.column<0>()) x += 1; // one contiguous span
+//   for (auto [x, y, id] : particles) { ... }      // zipped iteration
+//
+// Every mutation touches all columns, so they never get out of sync; a
+// push_back that throws part-way rolls back the columns already extended,
+// and erase_if/sort_by build the reordered columns aside before committing.
+
+template <typename... Ts> class soa_vector {
+  static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+  static_assert((!std::is_same_v<Ts, bool> && ...),
+                "std::vector<bool> has no contiguous storage; use std::uint8_t");
+
+  using Indices = std::index_sequence_for<Ts...>;
+
+public:
+  using value_type = std::tuple<Ts...>;
+  using reference = std::tuple<Ts &...>;
+  using const_reference = std::tuple<const Ts &...>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  template <std::size_t I>
+  using column_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+  // Random-access iterator yielding proxy rows. It models
+  // std::random_access_iterator, so range-for, std::ranges algorithms that
+  // only read, and views (filter, transform, take, ...) all work on it.
+  template <bool Const> class basic_iterator {
+    using Owner = std::conditional_t<Const, const soa_vector, soa_vector>;
+
+  public:
+    using value_type = std::tuple<Ts...>;
+    using reference =
+        std::conditional_t<Const, std::tuple<const Ts &...>, std::tuple<Ts &...>>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_concept = std::random_access_iterator_tag;
+
+    basic_iterator() = default;
+    basic_iterator(Owner *owner, size_type index) : owner_(owner), index_(index) {}
+    // iterator -> const_iterator (a template, so never the copy constructor)
+    template <bool OtherConst>
+      requires(Const && !OtherConst)
+    basic_iterator(const basic_iterator<OtherConst> &other)
+        : owner_(other.owner_), index_(other.index_) {}
+
+    reference operator*() const { return (*owner_)[index_]; }
+    reference operator[](difference_type n) const {
+      return (*owner_)[index_ + static_cast<size_type>(n)];
+    }
+
+    basic_iterator &operator++() {
+      ++index_;
+      return *this;
+    }
+    basic_iterator operator++(int) {
+      auto copy = *this;
+      ++index_;
+      return copy;
+    }
+    basic_iterator &operator--() {
+      --index_;
+      return *this;
+    }
+    basic_iterator operator--(int) {
+      auto copy = *this;
+      --index_;
+      return copy;
+    }
+    basic_iterator &operator+=(difference_type n) {
+      index_ = static_cast<size_type>(static_cast<difference_type>(index_) + n);
+      return *this;
+    }
+    basic_iterator &operator-=(difference_type n) { return *this += -n; }
+
+    friend basic_iterator operator+(basic_iterator it, difference_type n) {
+      return it += n;
+    }
+    friend basic_iterator operator+(difference_type n, basic_iterator it) {
+      return it += n;
+    }
+    friend basic_iterator operator-(basic_iterator it, difference_type n) {
+      return it -= n;
+    }
+    friend difference_type operator-(const basic_iterator &a,
+                                     const basic_iterator &b) {
+      return static_cast<difference_type>(a.index_) -
+             static_cast<difference_type>(b.index_);
+    }
+    friend bool operator==(const basic_iterator &a, const basic_iterator &b) {
+      return a.index_ == b.index_;
+    }
+    friend auto operator<=>(const basic_iterator &a, const basic_iterator &b) {
+      return a.index_ <=> b.index_;
+    }
+
+    size_type index() const noexcept { return index_; }
+
+  private:
+    friend class soa_vector;
+    template <bool> friend class basic_iterator;
+
+    Owner *owner_ = nullptr;
+    size_type index_ = 0;
+  };
+
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  soa_vector() = default;
+
+  // ---- Size and capacity ----------------------------------------------------
+
+  size_type size() const noexcept { return std::get<0>(columns_).size(); }
+  bool empty() const noexcept { return size() == 0; }
+
+  // Smallest capacity over all columns: rows that fit without reallocation
+  size_type capacity() const noexcept {
+    return std::apply(
+        [](const auto &...cols) { return std::min({cols.capacity()...}); },
+        columns_);
+  }
+
+  void reserve(size_type n) {
+    std::apply([n](auto &...cols) { (cols.reserve(n), ...); }, columns_);
+  }
+
+  void shrink_to_fit() {
+    std::apply([](auto &...cols) { (cols.shrink_to_fit(), ...); }, columns_);
+  }
+
+  void clear() noexcept {
+    std::apply([](auto &...cols) { (cols.clear(), ...); }, columns_);
+  }
+
+  // New rows are value-initialised
+  void resize(size_type n) {
+    std::apply([n](auto &...cols) { (cols.resize(n), ...); }, columns_);
+  }
+
+  // ---- Element access -------------------------------------------------------
+
+  reference operator[](size_type i) noexcept { return row(i, Indices{}); }
+  const_reference operator[](size_type i) const noexcept {
+    return row(i, Indices{});
+  }
+
+  reference at(size_type i) {
+    if (i >= size())
+      throw std::out_of_range("soa_vector::at");
+    return (*this)[i];
+  }
+  const_reference at(size_type i) const {
+    if (i >= size())
+      throw std::out_of_range("soa_vector::at");
+    return (*this)[i];
+  }
+
+  reference front() noexcept { return (*this)[0]; }
+  reference back() noexcept { return (*this)[size() - 1]; }
+
+  // One column as a contiguous span, e.g. for a vectorised loop
+  template <std::size_t I> std::span<column_type<I>> column() noexcept {
+    return std::get<I>(columns_);
+  }
+  template <std::size_t I> std::span<const column_type<I>> column() const noexcept {
+    return std::get<I>(columns_);
+  }
+
+  // ---- Modifiers ------------------------------------------------------------
+
+  void push_back(const Ts &...values) { append(values...); }
+  void push_back(Ts &&...values) { append(std::move(values)...); }
+  void push_back(const value_type &row) {
+    std::apply([this](const auto &...values) { append(values...); }, row);
+  }
+
+  // One constructor argument per column
+  template <typename... Args>
+    requires(sizeof...(Args) == sizeof...(Ts) &&
+             (std::is_constructible_v<Ts, Args &&> && ...))
+  reference emplace_back(Args &&...args) {
+    append(std::forward<Args>(args)...);
+    return back();
+  }
+
+  void pop_back() {
+    std::apply([](auto &...cols) { (cols.pop_back(), ...); }, columns_);
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    const auto begin_offset = static_cast<difference_type>(first.index_);
+    const auto end_offset = static_cast<difference_type>(last.index_);
+    std::apply(
+        [&](auto &...cols) {
+          (cols.erase(cols.begin() + begin_offset, cols.begin() + end_offset),
+           ...);
+        },
+        columns_);
+    return iterator(this, first.index_);
+  }
+
+  // O(1) removal that does not preserve order: the last row moves into `i`
+  void swap_remove(size_type i) {
+    std::apply(
+        [i](auto &...cols) {
+          ((cols[i] = std::move(cols.back()), cols.pop_back()), ...);
+        },
+        columns_);
+  }
+
+  // Erases the rows whose proxy satisfies `pred`; returns how many
+  template <typename Pred> size_type erase_if(Pred pred) {
+    std::vector<size_type> keep;
+    keep.reserve(size());
+    for (size_type i = 0; i < size(); ++i) {
+      if (!std::invoke(pred, std::as_const(*this)[i]))
+        keep.push_back(i);
+    }
+    const size_type removed = size() - keep.size();
+    if (removed != 0)
+      select_rows(keep);
+    return removed;
+  }
+
+  // Stable sort of all columns by proj(row). Sorts a permutation once and
+  // applies it to every column, instead of swapping whole rows through
+  // proxies (which std::ranges::sort cannot do with tuple-of-reference
+  // proxies before C++23 library support).
+  template <typename Proj, typename Comp = std::ranges::less>
+  void sort_by(Proj proj, Comp comp = {}) {
+    std::vector<size_type> order(size());
+    std::iota(order.begin(), order.end(), size_type{0});
+    std::stable_sort(order.begin(), order.end(), [&](size_type a, size_type b) {
+      return std::invoke(comp, std::invoke(proj, std::as_const(*this)[a]),
+                         std::invoke(proj, std::as_const(*this)[b]));
+    });
+    select_rows(order);
+  }
+
+  // Sort by one column
+  template <std::size_t I, typename Comp = std::ranges::less>
+  void sort_by_column(Comp comp = {}) {
+    sort_by([](const const_reference &r) -> const column_type<I> & {
+      return std::get<I>(r);
+    }, comp);
+  }
+
+  // ---- Iteration ------------------------------------------------------------
+
+  iterator begin() noexcept { return iterator(this, 0); }
+  iterator end() noexcept { return iterator(this, size()); }
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+  const_iterator end() const noexcept { return const_iterator(this, size()); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+private:
+  template <std::size_t... Is>
+  reference row(size_type i, std::index_sequence<Is...>) noexcept {
+    return reference(std::get<Is>(columns_)[i]...);
+  }
+  template <std::size_t... Is>
+  const_reference row(size_type i, std::index_sequence<Is...>) const noexcept {
+    return const_reference(std::get<Is>(columns_)[i]...);
+  }
+
+  // Appends one value per column; on failure removes what was appended
+  template <typename... Args> void append(Args &&...args) {
+    append_impl(Indices{}, std::forward<Args>(args)...);
+  }
+
+  template <std::size_t... Is, typename... Args>
+  void append_impl(std::index_sequence<Is...>, Args &&...args) {
+    std::size_t pushed = 0;
+    try {
+      ((std::get<Is>(columns_).emplace_back(std::forward<Args>(args)), ++pushed),
+       ...);
+    } catch (...) {
+      ((Is < pushed ? std::get<Is>(columns_).pop_back() : void()), ...);
+      throw;
+    }
+  }
+
+  // Rebuilds every column from the rows listed in `rows`, in that order.
+  // Strong guarantee: the new columns are built beside the old ones and
+  // swapped in together. All storage is reserved first, columns that must be
+  // copied (throwing move) are filled before any element is moved out, and
+  // after that nothing can throw. (A move-only type whose move throws is the
+  // exception, as with std::vector.)
+  void select_rows(const std::vector<size_type> &rows) {
+    select_rows_impl(rows, Indices{});
+  }
+
+  template <std::size_t... Is>
+  void select_rows_impl(const std::vector<size_type> &rows,
+                        std::index_sequence<Is...>) {
+    std::tuple<std::vector<Ts>...> fresh;
+    (std::get<Is>(fresh).reserve(std::get<Is>(columns_).capacity()), ...);
+    auto fill = [&](auto &out, auto &col) {
+      for (size_type r : rows)
+        out.push_back(std::move_if_noexcept(col[r]));
+    };
+    ((std::is_nothrow_move_constructible_v<Ts>
+          ? void()
+          : fill(std::get<Is>(fresh), std::get<Is>(columns_))),
+     ...);
+    ((std::is_nothrow_move_constructible_v<Ts>
+          ? fill(std::get<Is>(fresh), std::get<Is>(columns_))
+          : void()),
+     ...);
+    columns_.swap(fresh);
+  }
+
+  std::tuple<std::vector<Ts>...> columns_;
+};
@@ -1,9 +1,21 @@
 #include "TMPSample.hpp"
+#include "DualPath.hpp"
+#include "ExpressionTemplates.hpp"
+#include "FieldDescriptors.hpp"
+#include "OrderedSingleton.hpp"
+#include "SoaVector.hpp"
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <numeric>
+#include <ranges>
+#include <sstream>
+#include <unordered_set>
 #include <concepts>
 #include <iostream>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <vector>
@@ -196,6 +208,98 @@ void TMPSample::demonstrate_variadic_templates() {
   print_tuple(t);
 }
 
+// ----- 3b. soa_vector<Ts...>: one contiguous column per pack element ---------
+
+using Particles = soa_vector<float, float, float, float, std::uint32_t>;
+static_assert(std::random_access_iterator<Particles::iterator>);
+static_assert(std::ranges::random_access_range<Particles>);
+
+// The same particle as one struct per element, for comparison
+struct ParticleAoS {
+  float x, y, vx, vy;
+  std::uint32_t id;
+  float mass, charge, age; // Cold fields the hot loop never touches
+};
+
+void TMPSample::demonstrate_soa_vector() {
+  std::cout << "\n=== soa_vector<Ts...> (structure of arrays) ===\n";
+
+  soa_vector<std::string, int, double> people;
+  people.reserve(8);
+  people.push_back("Ada", 36, 1.65);
+  people.emplace_back("Linus", 28, 1.77);
+  people.push_back(std::make_tuple(std::string("Grace"), 45, 1.60));
+  people.emplace_back("Dennis", 30, 1.80);
+
+  auto [name, age, height] = people[1]; // proxy: references into the columns
+  age += 1;
+  std::cout << name << " is now " << std::get<1>(people[1]) << " ("
+            << height << " m)\n";
+
+  people.sort_by_column<1>();
+  std::cout << "sort_by_column<1> (age):";
+  for (auto [n, a, h] : people)
+    std::cout << " " << n << "/" << a;
+  std::cout << "\n";
+
+  people.sort_by([](const auto &row) { return std::get<2>(row); },
+                 std::ranges::greater{});
+  std::cout << "sort_by(height, greater):";
+  for (const auto &n : people.column<0>())
+    std::cout << " " << n;
+  std::cout << "\n";
+
+  people.erase(people.begin());
+  people.erase_if([](const auto &row) { return std::get<1>(row) > 40; });
+  std::cout << "after erase + erase_if(age > 40): " << people.size()
+            << " rows, columns in sync: "
+            << (people.column<0>().size() == people.column<2>().size()) << "\n";
+
+  // Views compose with the proxy iterator
+  auto adults = people | std::views::filter([](const auto &row) {
+                  return std::get<1>(row) >= 30;
+                });
+  std::cout << "views::filter(age >= 30):";
+  for (auto [n, a, h] : adults)
+    std::cout << " " << n;
+  std::cout << "\n";
+
+  // Hot loop over 2 of 8 fields: SoA streams only the two float columns
+  constexpr std::size_t count = 1'000'000;
+  Particles soa;
+  std::vector<ParticleAoS> aos;
+  soa.reserve(count);
+  aos.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const float f = static_cast<float>(i % 1000);
+    soa.push_back(f, -f, 0.5f, 0.25f, static_cast<std::uint32_t>(i));
+    aos.push_back({f, -f, 0.5f, 0.25f, static_cast<std::uint32_t>(i), 1.f, 0.f, 0.f});
+  }
+
+  auto time_ms = [](auto &&fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  };
+  const double aos_ms = time_ms([&] {
+    for (int step = 0; step < 10; ++step)
+      for (auto &p : aos)
+        p.x += p.vx;
+  });
+  const double soa_ms = time_ms([&] {
+    auto x = soa.column<0>();
+    auto vx = soa.column<2>();
+    for (int step = 0; step < 10; ++step)
+      for (std::size_t i = 0; i < x.size(); ++i)
+        x[i] += vx[i];
+  });
+  std::cout << "x += vx over 1M particles x10: AoS " << aos_ms << " ms, SoA "
+            << soa_ms << " ms (x[42]: " << aos[42].x << " / "
+            << soa.column<0>()[42] << ")\n";
+}
+
 // =============================================================================
 // 4. IF CONSTEXPR — compile-time branch selection (C++17)
 // =============================================================================
@@ -293,6 +397,86 @@ void TMPSample::demonstrate_fold_expressions() {
   std::cout << "\n";
 }
 
+// ----- 5b. Expression templates: folds over vectors build a lazy tree --------
+
+// The same fold as fold_sum, but over expressions: (a + (b + (c + d))) is a
+// tree of nodes, evaluated later in one loop
+template <etl::Expr... Es> auto lazy_fold_sum(const Es &...es) {
+  return (es + ...);
+}
+
+// The classic alternative: each operator returns a new std::vector
+namespace naive {
+using Vec = std::vector<double>;
+
+Vec operator+(const Vec &a, const Vec &b) {
+  Vec r(a.size());
+  for (std::size_t i = 0; i < a.size(); ++i)
+    r[i] = a[i] + b[i];
+  return r;
+}
+Vec operator-(const Vec &a, const Vec &b) {
+  Vec r(a.size());
+  for (std::size_t i = 0; i < a.size(); ++i)
+    r[i] = a[i] - b[i];
+  return r;
+}
+Vec operator*(const Vec &a, const Vec &b) {
+  Vec r(a.size());
+  for (std::size_t i = 0; i < a.size(); ++i)
+    r[i] = a[i] * b[i];
+  return r;
+}
+} // namespace naive
+
+void TMPSample::demonstrate_expression_templates() {
+  std::cout << "\n=== Expression Templates (lazy vector arithmetic) ===\n";
+
+  etl::vec<double> a{1, 2, 3, 4}, b{10, 20, 30, 40}, c{2, 2, 2, 2},
+      d{0.5, 0.5, 0.5, 0.5};
+  auto expr = a + b * c - d; // Nothing computed yet
+  etl::vec<double> r = expr; // One loop
+  std::cout << "a + b * c - d = ";
+  for (double v : r)
+    std::cout << v << " ";
+  std::cout << "\n";
+  std::cout << "expression node size: " << sizeof(expr)
+            << " bytes (references + op tags), no buffers\n";
+
+  etl::vec<double> folded = lazy_fold_sum(a, b, c, d);
+  std::cout << "lazy_fold_sum(a,b,c,d)[3] = " << folded[3] << "\n";
+  std::cout << "sum(a * 2.0 + 1.0) = " << etl::sum(a * 2.0 + 1.0) << "\n";
+  std::cout << "dot(a, b) = " << etl::dot(a, b) << "\n";
+  std::cout << "all_of(a > 0) = " << etl::all_of(a > 0.0)
+            << ", any_of(a - 3.5 > 0) = " << etl::any_of(a - 3.5 > 0.0)
+            << ", count(b > 15 && b < 35) = "
+            << etl::count(b > 15.0 && b < 35.0) << "\n";
+
+  // Benchmark: r = a + b * c - d over large arrays
+  constexpr std::size_t n = 1'000'000;
+  constexpr int reps = 20;
+  etl::vec<double> ea(n, 1.5), eb(n, 2.0), ec(n, 3.0), ed(n, 0.5), er(n);
+  naive::Vec na(n, 1.5), nb(n, 2.0), nc(n, 3.0), nd(n, 0.5), nr;
+
+  auto time_ms = [](auto &&fn) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < reps; ++i)
+      fn();
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+               .count() /
+           reps;
+  };
+  const double naive_ms = time_ms([&] {
+    using naive::operator+, naive::operator-, naive::operator*;
+    nr = na + nb * nc - nd; // 3 loops, 3 allocations
+  });
+  const double fused_ms = time_ms([&] { er = ea + eb * ec - ed; });
+  std::cout << "r = a + b * c - d over 1M doubles: naive std::vector ops "
+            << naive_ms << " ms, expression templates " << fused_ms
+            << " ms (r[0]: " << nr[0] << " / " << er[0] << ")\n";
+}
+
 // =============================================================================
 // 6. TEMPLATE SPECIALIZATION — full & partial
 // =============================================================================
@@ -451,23 +635,27 @@ template <double Value> struct CompileTimeDouble {
 // Template lambda (C++20)
 auto gen_adder = []<typename T>(T a, T b) -> T { return a + b; };
 
-// std::is_constant_evaluated() (C++20)
+// std::is_constant_evaluated() (C++20): the same call uses the loop at compile
+// time and the table that loop generated at runtime (see DualPath.hpp)
 constexpr int adaptive_fn(int n) {
-  if (std::is_constant_evaluated()) {
-    // Compile-time path
-    int result = 1;
-    for (int i = 1; i <= n; ++i)
-      result *= i;
-    return result;
-  } else {
-    // Runtime path (could use a lookup table, etc.)
-    int result = 1;
-    for (int i = 1; i <= n; ++i)
-      result *= i;
-    return result;
-  }
+  if (n < 0)
+    return 1;  // Empty product, as the loop form gave
+  return static_cast<int>(dual::factorial(static_cast<unsigned>(n)));
 }
 
+// A runtime kernel for a domain too large to tabulate: the evaluator's result
+// is cached instead
+struct collatz_steps_eval {
+  constexpr unsigned operator()(std::uint64_t n) const {
+    unsigned steps = 0;
+    for (; n != 1; ++steps)
+      n = (n % 2 == 0) ? n / 2 : 3 * n + 1;
+    return steps;
+  }
+};
+inline constexpr dual::dual_path collatz_steps{
+    collatz_steps_eval{}, dual::memo_kernel<collatz_steps_eval>{}};
+
 void TMPSample::demonstrate_cpp20_tmp() {
   std::cout << "\n=== C++20 TMP Features ===\n";
 
@@ -490,6 +678,40 @@ void TMPSample::demonstrate_cpp20_tmp() {
   std::cout << "adaptive_fn(5) at compile-time = " << ct << "\n";
   std::cout << "adaptive_fn(5) at runtime      = " << rt << "\n";
 
+  // dual_path: compile-time evaluator + runtime table / cache
+  static_assert(dual::factorial(20) == 2432902008176640000ull);
+  static_assert(dual::fibonacci(93) == 12200160415121876738ull);
+  static_assert(dual::power(-3, 5) == -243);
+  static_assert(collatz_steps(27u) == 111);
+  volatile unsigned n = 20; // keep the argument opaque to the optimiser
+  std::cout << "dual::factorial(20) [table] = " << dual::factorial(n) << "\n";
+  std::cout << "dual::fibonacci(90) [table] = " << dual::fibonacci(n + 70) << "\n";
+  std::cout << "dual::power(7, 15)  [table] = " << dual::power(7, n - 5) << "\n";
+  std::cout << "dual::power(3, 30)  [eval]  = " << dual::power(3, n + 10)
+            << "  (outside the table)\n";
+  std::cout << "collatz_steps(837799) [memo] = " << collatz_steps(std::uint64_t{837799})
+            << "\n";
+
+  // Runtime cost: evaluator loop vs table lookup over the whole domain
+  {
+    constexpr int rounds = 20000;
+    volatile unsigned last = 93; // opaque bound: no constant folding
+    std::uint64_t sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r)
+      for (unsigned i = 0; i <= last; ++i)
+        sink += dual::fibonacci.evaluator()(i);
+    auto t1 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r)
+      for (unsigned i = 0; i <= last; ++i)
+        sink += dual::fibonacci(i);
+    auto t2 = std::chrono::steady_clock::now();
+    using ms = std::chrono::duration<double, std::milli>;
+    std::cout << "fibonacci(0..93) x " << rounds << ": loop "
+              << ms(t1 - t0).count() << " ms, table " << ms(t2 - t1).count()
+              << " ms  (checksum " << (sink & 0xFFFF) << ")\n";
+  }
+
   // Comparison of TMP evolution
   std::cout << "\n=== TMP Evolution Table ===\n";
   std::cout << "+----------+--------------------------------------------+\n";
@@ -761,6 +983,291 @@ void TMPSample::demonstrate_macros_vs_templates() {
       << "+-------------------------+-----------------------------------+\n";
 }
 
+// =============================================================================
+// 10. FIELD DESCRIPTORS — reflection-lite from NTTP member pointers
+// =============================================================================
+// Each record lists its fields once (see FieldDescriptors.hpp); encoding,
+// hashing, comparison, printing and SoA splitting are generated from the list
+// instead of being written by hand per record.
+
+struct Trade {
+  std::uint64_t timestamp;
+  double price;
+  std::int32_t quantity;
+  std::uint32_t venue;
+
+  using fields = reflect::field_list<reflect::field<&Trade::timestamp, "timestamp">,
+                                     reflect::field<&Trade::price, "price">,
+                                     reflect::field<&Trade::quantity, "quantity">,
+                                     reflect::field<&Trade::venue, "venue">>;
+};
+
+// A type we "cannot edit": described from outside via the trait
+struct Order {
+  std::string symbol;
+  Trade fill;
+  std::int16_t flags;
+};
+
+template <> struct reflect::descriptor<Order> {
+  using fields = reflect::field_list<reflect::field<&Order::symbol, "symbol">,
+                                     reflect::field<&Order::fill, "fill">,
+                                     reflect::field<&Order::flags, "flags">>;
+};
+
+static_assert(reflect::field_count<Trade> == 4);
+static_assert(std::is_same_v<reflect::field_type<Trade, 1>, double>);
+static_assert(reflect::field_offsets<Trade>()[2] == 16);
+#ifdef REFLECT_HAS_CONSTEXPR_MEMBER_ORDER
+static_assert(reflect::memcpy_layout<Trade>);
+#endif
+static_assert(!reflect::memcpy_layout<Order>); // std::string, padding
+static_assert(!reflect::fixed_size<Order>);
+
+// Same fields as Trade, listed out of declaration order: still encodable, but
+// the memory image is no longer the wire format
+struct ShuffledTrade {
+  std::uint64_t timestamp;
+  double price;
+  std::int32_t quantity;
+  std::uint32_t venue;
+
+  using fields = reflect::field_list<reflect::field<&ShuffledTrade::price, "price">,
+                                     reflect::field<&ShuffledTrade::timestamp, "timestamp">,
+                                     reflect::field<&ShuffledTrade::quantity, "quantity">,
+                                     reflect::field<&ShuffledTrade::venue, "venue">>;
+};
+static_assert(!reflect::memcpy_layout<ShuffledTrade>);
+
+template <typename T>
+std::vector<T> make_trades(std::size_t count) {
+  std::vector<T> trades(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    trades[i].timestamp = 1'700'000'000'000ULL + i;
+    trades[i].price = 100.0 + static_cast<double>(i % 100) * 0.25;
+    trades[i].quantity = static_cast<std::int32_t>(i % 500) + 1;
+    trades[i].venue = static_cast<std::uint32_t>(i % 7);
+  }
+  return trades;
+}
+
+template <typename T>
+double time_encode_ms(const std::vector<T> &trades, std::vector<std::byte> &out) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int rep = 0; rep < 10; ++rep) {
+    out.clear();
+    reflect::encode_all(std::span<const T>(trades), out);
+  }
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+             .count() /
+         10;
+}
+
+void TMPSample::demonstrate_field_descriptors() {
+  std::cout << "\n=== Field Descriptors (reflection-lite) ===\n";
+
+  std::cout << "Trade fields:";
+  for (auto name : reflect::field_names<Trade>())
+    std::cout << " " << name;
+  std::cout << "\nwire_size<Trade> = " << reflect::wire_size<Trade>
+            << ", memcpy_layout<Trade> = " << reflect::memcpy_layout<Trade>
+            << ", memcpy_layout<Order> = " << reflect::memcpy_layout<Order>
+            << "\n";
+
+  // Generated printing / reading replace hand-written print() and input()
+  Order order{"ACME", {1'700'000'000'000ULL, 101.25, 300, 2}, 5};
+  std::cout << "print_fields(order): ";
+  reflect::print_fields(std::cout, order);
+  std::cout << "\n";
+
+  Order parsed{};
+  std::istringstream text("GLOBX 42 99.5 10 3 1");
+  reflect::read_fields(text, parsed);
+  std::cout << "read_fields(\"GLOBX 42 99.5 10 3 1\"): ";
+  reflect::print_fields(std::cout, parsed);
+  std::cout << "\n";
+
+  // Binary round trip through the generated encoder/decoder
+  std::vector<std::byte> wire;
+  reflect::encode(order, wire);
+  Order decoded{};
+  const std::size_t used = reflect::decode(std::span<const std::byte>(wire), decoded);
+  std::cout << "Order encoded in " << wire.size() << " bytes, decoded " << used
+            << " bytes, round trip equal: "
+            << reflect::fields_equal(order, decoded) << "\n";
+
+  // Generated hash and comparison
+  std::unordered_set<Trade, reflect::field_hash, decltype([](const Trade &a, const Trade &b) {
+                       return reflect::fields_equal(a, b);
+                     })>
+      unique;
+  for (const Trade &t : make_trades<Trade>(1000))
+    unique.insert(t);
+  unique.insert(order.fill);
+  unique.insert(order.fill);
+  std::cout << "unordered_set<Trade, field_hash>: " << unique.size()
+            << " distinct of 1002 inserted\n";
+  const Trade cheaper{order.fill.timestamp, 100.0, 300, 2};
+  std::cout << "fields_compare(fill, cheaper) > 0: "
+            << (reflect::fields_compare(order.fill, cheaper) > 0) << "\n";
+
+  // SoA splitter: each field becomes one contiguous, vectorisable column
+  const auto trades = make_trades<Trade>(200'000);
+  auto cols = reflect::split_columns(std::span<const Trade>(trades));
+  const auto &prices = std::get<1>(cols);
+  const auto &quantities = std::get<2>(cols);
+  const double notional = std::transform_reduce(
+      prices.begin(), prices.end(), quantities.begin(), 0.0);
+  std::cout << "split_columns: " << prices.size()
+            << " prices as one std::vector<double>, notional = " << notional
+            << ", join_columns round trip equal: "
+            << (reflect::join_columns<Trade>(cols).back().price ==
+                trades.back().price)
+            << "\n";
+
+  // memcpy fast path vs. the field-by-field encoder for the same data
+  std::vector<std::byte> fast_out, slow_out;
+  const double fast_ms = time_encode_ms(trades, fast_out);
+  const double slow_ms = time_encode_ms(make_trades<ShuffledTrade>(trades.size()), slow_out);
+  std::cout << "encode_all 200k trades: memcpy fast path " << fast_ms
+            << " ms, field-by-field " << slow_ms << " ms ("
+            << fast_out.size() << " bytes each: "
+            << (fast_out.size() == slow_out.size()) << ")\n";
+  const auto back = reflect::decode_all<Trade>(fast_out);
+  std::cout << "decode_all: " << back.size() << " trades, last equal: "
+            << reflect::fields_equal(back.back(), trades.back()) << "\n";
+}
+
+// =============================================================================
+// 11. ORDERED SINGLETONS — explicit, measured startup instead of static init
+// =============================================================================
+// Singleton<Derived> above constructs on first call and checks a guard on
+// every call. OrderedSingleton (OrderedSingleton.hpp) takes its dependencies
+// as template arguments, so a registry can construct everything in a known
+// order at a chosen point, and instance() afterwards is one pointer load.
+
+using namespace std::chrono_literals;
+
+// Simulated startup cost of a service
+void simulate_startup(std::chrono::milliseconds cost) {
+  std::this_thread::sleep_for(cost);
+}
+
+class AppConfig : public startup::OrderedSingleton<AppConfig> {
+  friend class startup::OrderedSingleton<AppConfig>;
+  AppConfig() { simulate_startup(4ms); }
+
+public:
+  static constexpr std::string_view singleton_name = "AppConfig";
+  int pool_size = 8;
+};
+
+class AppLogger : public startup::OrderedSingleton<AppLogger, AppConfig> {
+  friend class startup::OrderedSingleton<AppLogger, AppConfig>;
+  AppLogger() { simulate_startup(3ms); }
+
+public:
+  static constexpr std::string_view singleton_name = "AppLogger";
+};
+
+class MetricsSink : public startup::OrderedSingleton<MetricsSink, AppConfig> {
+  friend class startup::OrderedSingleton<MetricsSink, AppConfig>;
+  MetricsSink() { simulate_startup(6ms); }
+
+public:
+  static constexpr std::string_view singleton_name = "MetricsSink";
+};
+
+class ConnectionPool
+    : public startup::OrderedSingleton<ConnectionPool, AppConfig, AppLogger> {
+  friend class startup::OrderedSingleton<ConnectionPool, AppConfig, AppLogger>;
+  // Dependencies are guaranteed to exist already
+  ConnectionPool() : size(AppConfig::instance().pool_size) {
+    simulate_startup(12ms);
+  }
+
+public:
+  static constexpr std::string_view singleton_name = "ConnectionPool";
+  int size;
+};
+
+class GeoIpTable : public startup::OrderedSingleton<GeoIpTable> {
+  friend class startup::OrderedSingleton<GeoIpTable>;
+  GeoIpTable() { simulate_startup(10ms); }
+
+public:
+  static constexpr std::string_view singleton_name = "GeoIpTable";
+};
+
+// Only needed by rare requests: left to first use
+class PdfRenderer : public startup::OrderedSingleton<PdfRenderer, AppLogger> {
+  friend class startup::OrderedSingleton<PdfRenderer, AppLogger>;
+  PdfRenderer() { simulate_startup(5ms); }
+
+public:
+  static constexpr std::string_view singleton_name = "PdfRenderer";
+};
+
+class CycleA;
+class CycleB;
+class CycleA : public startup::OrderedSingleton<CycleA, CycleB> {
+public:
+  static constexpr std::string_view singleton_name = "CycleA";
+};
+class CycleB : public startup::OrderedSingleton<CycleB, CycleA> {
+public:
+  static constexpr std::string_view singleton_name = "CycleB";
+};
+
+void TMPSample::demonstrate_ordered_singletons() {
+  std::cout << "\n=== Ordered Singletons ===\n";
+  auto elapsed_ms = [](auto start) {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  };
+
+  {
+    // Registration order is irrelevant: dependencies are pulled in first
+    startup::SingletonRegistry registry;
+    registry.add_all<ConnectionPool, MetricsSink, GeoIpTable>();
+    const auto start = std::chrono::steady_clock::now();
+    registry.init_all();
+    std::cout << "init_all (one thread): " << registry.size()
+              << " singletons in " << elapsed_ms(start) << " ms\n";
+    registry.report(std::cout);
+  } // shutdown: destroyed in reverse construction order
+
+  {
+    startup::SingletonRegistry registry;
+    registry.add_all<ConnectionPool, MetricsSink, GeoIpTable>();
+    const auto start = std::chrono::steady_clock::now();
+    registry.init_parallel(4);
+    std::cout << "init_parallel(4): " << registry.size() << " singletons in "
+              << elapsed_ms(start) << " ms (critical path AppConfig -> "
+                 "AppLogger -> ConnectionPool = 19 ms)\n";
+    std::cout << "ConnectionPool::instance().size = "
+              << ConnectionPool::instance().size << "\n";
+
+    // Deferred: constructed by whichever request needs it first
+    std::cout << "PdfRenderer initialised before first use: "
+              << PdfRenderer::initialized() << "\n";
+    PdfRenderer::get_or_init();
+    std::cout << "PdfRenderer initialised after get_or_init(): "
+              << PdfRenderer::initialized() << "\n";
+    registry.add<PdfRenderer>(); // Tracked for the report and shutdown
+    registry.report(std::cout);
+  }
+
+  try {
+    startup::SingletonRegistry registry;
+    registry.add<CycleA>();
+  } catch (const std::logic_error &e) {
+    std::cout << "Cycle rejected at registration: " << e.what() << "\n";
+  }
+}
+
 // =============================================================================
 // run() — entry point
 // =============================================================================
@@ -773,12 +1280,16 @@ void TMPSample::run() {
   demonstrate_compile_time_values();
   demonstrate_type_traits();
   demonstrate_variadic_templates();
+  demonstrate_soa_vector();
   demonstrate_if_constexpr();
   demonstrate_fold_expressions();
+  demonstrate_expression_templates();
   demonstrate_template_specialization();
   demonstrate_sfinae_vs_concepts();
   demonstrate_cpp20_tmp();
   demonstrate_macros_vs_templates();
+  demonstrate_field_descriptors();
+  demonstrate_ordered_singletons();
 
   std::cout << "\n=== TMP Summary ===\n";
   std::cout << "Template Meta Programming moves computation from runtime to "
@@ -788,12 +1299,17 @@ void TMPSample::run() {
       << "  - Recursive struct templates & constexpr for compile-time values\n";
   std::cout << "  - Type traits for type inspection and transformation\n";
   std::cout << "  - Variadic templates for generic N-ary operations\n";
+  std::cout << "  - Type packs as containers: soa_vector<Ts...>\n";
   std::cout << "  - if constexpr for zero-cost compile-time branching\n";
   std::cout << "  - Fold expressions for compact variadic operations\n";
+  std::cout << "  - Expression templates for fused, temporary-free arithmetic\n";
   std::cout << "  - Template specialization for type-specific behavior\n";
   std::cout << "  - SFINAE / Concepts for constraining templates\n";
   std::cout << "  - C++20: consteval, NTTPs, template lambdas\n";
+  std::cout << "  - is_constant_evaluated: compile-time evaluator, runtime table\n";
   std::cout << "  - Templates as a type-safe, debuggable macro replacement\n";
+  std::cout << "  - NTTP member-pointer field lists as reflection-lite\n";
+  std::cout << "  - Dependency lists as template arguments for ordered startup\n";
   std::cout << "\nTMP demonstration completed!\n";
 }
 
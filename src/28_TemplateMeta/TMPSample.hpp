@@ -12,10 +12,14 @@ private:
     void demonstrate_compile_time_values();
     void demonstrate_type_traits();
     void demonstrate_variadic_templates();
+    void demonstrate_soa_vector();
     void demonstrate_if_constexpr();
     void demonstrate_fold_expressions();
+    void demonstrate_expression_templates();
     void demonstrate_template_specialization();
     void demonstrate_sfinae_vs_concepts();
     void demonstrate_cpp20_tmp();
     void demonstrate_macros_vs_templates();
+    void demonstrate_field_descriptors();
+    void demonstrate_ordered_singletons();
 };
@@ -0,0 +1,271 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+// Monotonic arena that is also a std::pmr::memory_resource.
+//
+//   Arena arena;
+//   Widget* w = arena.make<Widget>(id, "name");          // forwarded into placement new
+//   Pinned* p = arena.make<Pinned>(InPlace{[] { ... }});  // factory elided in place
+//   {
+//       std::pmr::vector<std::pmr::string> v(&arena);     // containers on the arena
+//   }                                                     // ...gone before the reset
+//   arena.reset();                                        // everything gone, O(1)
+//
+// Allocation bumps a pointer inside the current block; blocks come from an
+// upstream resource and are kept across reset(), so a per-request arena stops
+// allocating after the first few requests. deallocate() is a no-op: memory
+// comes back only on reset() or destruction.
+//
+// ArenaMode::Release never runs destructors, like
+// std::pmr::monotonic_buffer_resource: objects from make<T> must be trivially
+// destructible, own only arena memory, or be handed back with destroy().
+// ArenaMode::Debug records every make<T> and every open pmr allocation. reset()
+// then destroys the objects still alive (newest first), reports them together
+// with the allocations nobody returned, and scribbles over the old memory so
+// that later use of it shows up quickly.
+
+enum class ArenaMode {
+    Release,
+    Debug,
+};
+
+// What was still alive when the arena was reset
+struct ArenaLeaks {
+    std::size_t objects = 0;     // make<T> objects never passed to destroy()
+    std::size_t allocations = 0; // pmr allocations never deallocated
+    std::size_t bytes = 0;       // Bytes held by those allocations
+    std::vector<std::string_view> types; // Mangled type names of the objects
+
+    explicit operator bool() const noexcept { return objects != 0 || allocations != 0; }
+};
+
+class Arena : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t default_block_size = 64 * 1024;
+
+#ifdef NDEBUG
+    static constexpr ArenaMode default_mode = ArenaMode::Release;
+#else
+    static constexpr ArenaMode default_mode = ArenaMode::Debug;
+#endif
+
+    explicit Arena(std::size_t block_size = default_block_size, ArenaMode mode = default_mode,
+                   std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : block_size_(std::max<std::size_t>(block_size, 256)), mode_(mode), upstream_(upstream),
+          objects_(upstream), allocations_(upstream) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() override {
+        (void)reset();
+        while (head_)
+            free_block(std::exchange(head_, head_->next));
+    }
+
+    // Constructs a T from args in arena memory. A single InPlace factory
+    // argument is elided straight into the slot, so immovable types work.
+    template <class T, class... Args> T* make(Args&&... args) {
+        void* memory = allocate_bytes(sizeof(T), alignof(T));
+        T* object = ::new (memory) T(std::forward<Args>(args)...);
+        if (mode_ == ArenaMode::Debug) {
+            try {
+                objects_.push_back({object, &destroy_as<T>, typeid(T).name()});
+            } catch (...) {
+                object->~T();
+                throw;
+            }
+        }
+        return object;
+    }
+
+    // Runs ~T now; the memory itself is reclaimed by the next reset()
+    template <class T> void destroy(T* object) noexcept {
+        if (!object)
+            return;
+        if (mode_ == ArenaMode::Debug) {
+            [[maybe_unused]] const bool known = forget(object);
+            assert(known && "Arena::destroy: object not made by this arena");
+        }
+        object->~T();
+    }
+
+    // Makes every byte reusable. O(1) in Release mode; in Debug mode it also
+    // destroys and reports whatever was still alive.
+    ArenaLeaks reset() noexcept {
+        ArenaLeaks leaks;
+        if (mode_ == ArenaMode::Debug) {
+            // The destructors may destroy() other records or make() new ones,
+            // so they run over a detached list until nothing is left
+            while (!objects_.empty()) {
+                auto dying = std::move(objects_);
+                objects_.clear();
+                dying_ = &dying;
+                for (auto it = dying.rbegin(); it != dying.rend(); ++it) {
+                    if (!it->object)
+                        continue; // Already destroyed by an owner's destructor
+                    ++leaks.objects;
+                    leaks.types.push_back(it->type);
+                    it->destroy(std::exchange(it->object, nullptr));
+                }
+                dying_ = nullptr;
+            }
+            // Counted after the destructors, which may have returned memory
+            leaks.allocations = allocations_.size();
+            for (const auto& a : allocations_)
+                leaks.bytes += a.bytes;
+            allocations_.clear();
+            // Blocks past current_ were already scribbled by an earlier reset
+            for (Block* b = head_; b && b != current_->next; b = b->next)
+                std::memset(b->data(), 0xDD, b->used);
+        }
+        // Later blocks are rewound lazily when allocation reaches them
+        current_ = head_;
+        if (current_)
+            current_->used = 0;
+        used_ = 0;
+        return leaks;
+    }
+
+    ArenaMode mode() const noexcept { return mode_; }
+    // Bytes handed out since the last reset (including alignment padding)
+    std::size_t bytes_used() const noexcept { return used_; }
+    // Blocks obtained from upstream over the arena's lifetime
+    std::size_t block_allocations() const noexcept { return block_allocations_; }
+
+private:
+    struct alignas(std::max_align_t) Block {
+        Block* next = nullptr;
+        std::size_t capacity = 0;
+        std::size_t used = 0;
+
+        std::byte* data() noexcept { return reinterpret_cast<std::byte*>(this + 1); }
+    };
+
+    struct ObjectRecord {
+        void* object;
+        void (*destroy)(void*) noexcept;
+        std::string_view type;
+    };
+
+    struct AllocationRecord {
+        void* pointer;
+        std::size_t bytes;
+    };
+
+    template <class T> static void destroy_as(void* object) noexcept {
+        static_cast<T*>(object)->~T();
+    }
+
+    // Drops the record of a live object; false if this arena never made it
+    bool forget(void* object) noexcept {
+        auto matches = [object](const ObjectRecord& r) { return r.object == object; };
+        auto it = std::find_if(objects_.rbegin(), objects_.rend(), matches);
+        if (it != objects_.rend()) {
+            objects_.erase(std::next(it).base());
+            return true;
+        }
+        // During reset() the survivors sit in the detached list
+        if (dying_) {
+            auto dying = std::find_if(dying_->begin(), dying_->end(), matches);
+            if (dying != dying_->end()) {
+                dying->object = nullptr;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        void* p = allocate_bytes(bytes, alignment);
+        if (mode_ == ArenaMode::Debug)
+            allocations_.push_back({p, bytes});
+        return p;
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t) override {
+        if (mode_ != ArenaMode::Debug)
+            return;
+        // Containers usually free their newest buffer first
+        auto it = std::find_if(allocations_.rbegin(), allocations_.rend(),
+                               [p](const AllocationRecord& r) { return r.pointer == p; });
+        assert(it != allocations_.rend() && it->bytes == bytes &&
+               "Arena: deallocate of memory this arena did not hand out");
+        if (it != allocations_.rend())
+            allocations_.erase(std::next(it).base());
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    void* allocate_bytes(std::size_t bytes, std::size_t alignment) {
+        if (current_) {
+            if (void* p = bump(*current_, bytes, alignment))
+                return p;
+            // Blocks after current_ are left over from before the last reset
+            while (current_->next) {
+                current_ = current_->next;
+                current_->used = 0;
+                if (void* p = bump(*current_, bytes, alignment))
+                    return p;
+            }
+        }
+        // A fresh block, at least big enough for this request
+        Block* block = new_block(std::max(block_size_, bytes + alignment));
+        if (current_) {
+            block->next = current_->next;
+            current_->next = block;
+        } else {
+            head_ = block;
+        }
+        current_ = block;
+        return bump(*block, bytes, alignment);
+    }
+
+    void* bump(Block& block, std::size_t bytes, std::size_t alignment) noexcept {
+        const auto base = reinterpret_cast<std::uintptr_t>(block.data());
+        const std::uintptr_t start = (base + block.used + alignment - 1) & ~(alignment - 1);
+        const std::size_t end = start - base + bytes;
+        if (end > block.capacity)
+            return nullptr;
+        used_ += end - block.used;
+        block.used = end;
+        return reinterpret_cast<void*>(start);
+    }
+
+    Block* new_block(std::size_t capacity) {
+        void* memory = upstream_->allocate(sizeof(Block) + capacity, alignof(Block));
+        ++block_allocations_;
+        auto* block = ::new (memory) Block;
+        block->capacity = capacity;
+        return block;
+    }
+
+    void free_block(Block* block) noexcept {
+        upstream_->deallocate(block, sizeof(Block) + block->capacity, alignof(Block));
+    }
+
+    std::size_t block_size_;
+    ArenaMode mode_;
+    std::pmr::memory_resource* upstream_;
+    Block* head_ = nullptr;
+    Block* current_ = nullptr;
+    std::size_t used_ = 0;
+    std::size_t block_allocations_ = 0;
+    std::pmr::vector<ObjectRecord> objects_;         // Debug mode only
+    std::pmr::vector<ObjectRecord>* dying_ = nullptr; // Being destroyed by reset()
+    std::pmr::vector<AllocationRecord> allocations_; // Debug mode only
+};
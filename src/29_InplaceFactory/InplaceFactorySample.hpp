@@ -44,6 +44,7 @@ private:
     void demonstrate_inplace_wrapper();
     void demonstrate_immovable_types();
     void demonstrate_vector_caveat();
+    void demonstrate_arena();
 
     // Helper class for demonstration
     class Tracer;
@@ -13,8 +13,11 @@
 #include "13_CopyAndSwap/CopyAndSwapSample.hpp"
 #include "14_CastingTypes/CastingTypesSample.hpp"
 #include "15_ThreadSafety/ThreadSafetySample.hpp"
+#include "15_ThreadSafety/WorkStealingPool.hpp"
 #include "16_Concepts/ConceptsSample.hpp"
 #include "17_Coroutines/CoroutinesSample.hpp"
+#include "17_Coroutines/IoReactor.hpp"
+#include "17_Coroutines/StructuredConcurrency.hpp"
 #include "18_SRP/SRPSample.hpp"
 #include "19_OCP/OCPSample.hpp"
 #include "20_LSP/LSPSample.hpp"
@@ -25,11 +28,27 @@
 #include "25_Projections/ProjectionsSample.hpp"
 #include "26_InputOutputStream/InputOutputStreamSample.hpp"
 #include "27_RTTI/RTTISample.hpp"
+#include "28_TemplateMeta/DualPath.hpp"
+#include "28_TemplateMeta/ExpressionTemplates.hpp"
+#include "28_TemplateMeta/SoaVector.hpp"
 #include "28_TemplateMeta/TMPSample.hpp"
+#include "29_InplaceFactory/Arena.hpp"
 #include "29_InplaceFactory/InplaceFactorySample.hpp"
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef CORO_HAS_ASYNC_FILE_IO
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 TEST(Samples, RAII) {
   RAIISample sample;
   // This will run the RAII demonstration
@@ -121,6 +140,17 @@ TEST(Samples, ThreadSafety) {
   sample.run();
 }
 
+// when_all of nothing has no pool to post to; then() must still run
+TEST(ThreadSafety, WhenAllOfNothingChains) {
+  concurrency::work_stealing_pool pool(2);
+  auto none = concurrency::when_all(std::vector<concurrency::pool_future<int>>{});
+  EXPECT_EQ(std::move(none).then([](std::vector<int> v) { return v.size() + 1; }).get(), 1u);
+
+  std::vector<concurrency::pool_future<int>> some;
+  for (int i = 0; i < 4; ++i) some.push_back(pool.submit([i] { return i; }));
+  EXPECT_EQ(concurrency::when_all(std::move(some)).then([](std::vector<int> v) { return v.size(); }).get(), 4u);
+}
+
 TEST(Samples, Concepts) {
   ConceptsSample sample;
   // This will run the C++20 Concepts demonstration
@@ -133,6 +163,74 @@ TEST(Samples, Coroutines) {
   sample.run();
 }
 
+// A failure before the deadline ends the race; only the timer firing yields nullopt
+TEST(Coroutines, DeadlineRethrowsEarlyFailure) {
+  using namespace std::chrono_literals;
+  const auto start = coro::Clock::now();
+  EXPECT_THROW(coro::sync_wait(coro::with_timeout(
+                   []() -> coro::Task<int> {
+                     throw std::runtime_error("failed");
+                     co_return 0;
+                   }(),
+                   10s)),
+               std::runtime_error);
+  EXPECT_LT(coro::Clock::now() - start, 5s);
+
+  auto late = coro::sync_wait(coro::with_timeout(
+      []() -> coro::Task<int> {
+        co_await coro::sleep_for(10s);
+        co_return 1;
+      }(),
+      10ms));
+  EXPECT_FALSE(late.has_value());
+}
+
+#ifdef CORO_HAS_ASYNC_FILE_IO
+// Both backends must write and read back the same bytes through real files
+TEST(Coroutines, AsyncFileIoRoundTrip) {
+  namespace fs = std::filesystem;
+  const fs::path path = fs::temp_directory_path() / ("coro_io_test_" + std::to_string(::getpid()) + ".bin");
+
+  for (auto backend : {coro::IoBackend::Auto, coro::IoBackend::ThreadPool}) {
+    std::vector<std::byte> fixed(256);
+    const std::span<std::byte> buffers[] = {fixed};
+    coro::IoReactor io({.backend = backend, .fixed_buffers = buffers});
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    ASSERT_GE(fd, 0);
+
+    std::vector<std::byte> out(10000);
+    for (std::size_t i = 0; i < out.size(); ++i) out[i] = static_cast<std::byte>(i % 251);
+    std::vector<std::byte> in(out.size() + 100);
+
+    auto [written, read] = coro::sync_wait(
+        [&]() -> coro::Task<std::pair<std::size_t, std::size_t>> {
+          // Two halves written concurrently at different offsets
+          auto halves = co_await coro::when_all(
+              [&]() -> coro::Task<std::size_t> { co_return co_await io.write(fd, std::span(out).first(5000), 0); }(),
+              [&]() -> coro::Task<std::size_t> { co_return co_await io.write(fd, std::span(out).subspan(5000), 5000); }());
+          std::size_t got = co_await io.read(fd, in, 0);
+          co_return std::pair{std::get<0>(halves) + std::get<1>(halves), got};
+        }());
+    EXPECT_EQ(written, out.size());
+    EXPECT_EQ(read, out.size());  // Short read at EOF
+    EXPECT_TRUE(std::equal(out.begin(), out.end(), in.begin()));
+    EXPECT_EQ(io.stats().operations, 3u);
+
+    // Fixed buffers are registered up front, before any read is in flight
+    const std::size_t fixed_read = coro::sync_wait(
+        [&]() -> coro::Task<std::size_t> { co_return co_await io.read_fixed(fd, 0, fixed.size(), 1000); }());
+    EXPECT_EQ(fixed_read, fixed.size());
+    EXPECT_TRUE(std::equal(fixed.begin(), fixed.end(), out.begin() + 1000));
+
+    // Errors surface as std::system_error at the co_await
+    EXPECT_THROW(coro::sync_wait([&]() -> coro::Task<std::size_t> { co_return co_await io.read(-1, in, 0); }()),
+                 std::system_error);
+    ::close(fd);
+  }
+  fs::remove(path);
+}
+#endif
+
 TEST(SOLID, SingleResponsibilityPrinciple) {
   SRPSample sample;
   // This will run the Single Responsibility Principle demonstration
@@ -199,12 +297,122 @@ TEST(Samples, TemplateMeta) {
   sample.run();
 }
 
+// Every runtime table entry must equal what the compile-time path produces
+TEST(TemplateMeta, DualPathAgreesOverDomain) {
+  // Built during constant evaluation, i.e. through the evaluator branch
+  constexpr auto ct_factorial = [] {
+    std::array<std::uint64_t, 21> values{};
+    for (unsigned n = 0; n < values.size(); ++n) values[n] = dual::factorial(n);
+    return values;
+  }();
+  constexpr auto ct_fibonacci = [] {
+    std::array<std::uint64_t, 94> values{};
+    for (unsigned n = 0; n < values.size(); ++n) values[n] = dual::fibonacci(n);
+    return values;
+  }();
+  constexpr auto ct_power = [] {
+    std::array<std::int64_t, 21 * 19> values{};
+    for (int base = -10; base <= 10; ++base)
+      for (unsigned exp = 0; exp <= 18; ++exp) values[static_cast<std::size_t>(base + 10) * 19 + exp] = dual::power(base, exp);
+    return values;
+  }();
+
+  for (unsigned n = 0; n < ct_factorial.size(); ++n) EXPECT_EQ(dual::factorial(n), ct_factorial[n]) << n;
+  for (unsigned n = 0; n < ct_fibonacci.size(); ++n) EXPECT_EQ(dual::fibonacci(n), ct_fibonacci[n]) << n;
+  for (int base = -10; base <= 10; ++base)
+    for (unsigned exp = 0; exp <= 18; ++exp)
+      EXPECT_EQ(dual::power(base, exp), ct_power[static_cast<std::size_t>(base + 10) * 19 + exp]) << base << "^" << exp;
+
+  // Spot checks against independent values
+  EXPECT_EQ(dual::factorial(20u), 2432902008176640000ull);
+  EXPECT_EQ(dual::fibonacci(93u), 12200160415121876738ull);
+  EXPECT_EQ(dual::power(-10, 18u), 1000000000000000000ll);
+
+  // Outside the table the runtime kernel falls back to the evaluator
+  EXPECT_FALSE(std::remove_cvref_t<decltype(dual::power.kernel())>::covers(11, 2u));
+  EXPECT_EQ(dual::power(11, 2u), 121);
+  EXPECT_EQ(dual::power(2, 40u), 1ll << 40);
+}
+
+// init is folded in once, whatever the lane count and length
+TEST(TemplateMeta, ReduceAppliesInitOnce) {
+  for (std::size_t n : {0u, 1u, 3u, 4u, 5u, 9u, 17u}) {
+    etl::vec<int> v(n);
+    for (std::size_t i = 0; i < n; ++i) v[i] = static_cast<int>(i + 1);
+    const int total = static_cast<int>(n * (n + 1) / 2);
+    EXPECT_EQ(etl::reduce(v, 10, std::plus<>{}), total + 10) << n;
+    EXPECT_EQ(etl::reduce<3>(v, 10, std::plus<>{}), total + 10) << n;
+    EXPECT_EQ(etl::reduce(v * 0 + 1, 3, std::multiplies<>{}), 3) << n;
+  }
+}
+
+namespace {
+// Copies fail once the budget runs out; the move may throw, so reordering copies it
+struct CopyBudget {
+  static inline int remaining = 0;
+  int value;
+  explicit CopyBudget(int v) : value(v) {}
+  CopyBudget(const CopyBudget &other) : value(other.value) {
+    if (--remaining < 0) throw std::runtime_error("copy budget exhausted");
+  }
+  CopyBudget(CopyBudget &&other) noexcept(false) : value(other.value) {}
+  CopyBudget &operator=(const CopyBudget &) = default;
+  CopyBudget &operator=(CopyBudget &&) = default;
+};
+} // namespace
+
+// A reorder that throws part-way leaves every column as it was
+TEST(TemplateMeta, SoaReorderIsAllOrNothing) {
+  soa_vector<std::string, CopyBudget, int> rows;
+  CopyBudget::remaining = 100;
+  for (int i = 0; i < 6; ++i) rows.push_back(std::string(32, static_cast<char>('a' + i)), CopyBudget{i}, i);
+
+  CopyBudget::remaining = 3;
+  EXPECT_THROW(rows.sort_by([](auto row) { return -std::get<2>(row); }), std::runtime_error);
+  ASSERT_EQ(rows.size(), 6u);
+  for (int i = 0; i < 6; ++i) {
+    auto [text, budget, id] = rows[static_cast<std::size_t>(i)];
+    EXPECT_EQ(text, std::string(32, static_cast<char>('a' + i)));
+    EXPECT_EQ(budget.value, i);
+    EXPECT_EQ(id, i);
+  }
+
+  CopyBudget::remaining = 100;
+  EXPECT_EQ(rows.erase_if([](auto row) { return std::get<2>(row) % 2 != 0; }), 3u);
+  EXPECT_EQ(std::get<0>(rows[1])[0], 'c');
+  EXPECT_EQ(std::get<1>(rows[1]).value, 2);
+}
+
 TEST(Samples, InplaceFactory) {
   InplaceFactorySample sample;
   // This will run the In-Place Factory demonstration
   sample.run();
 }
 
+// A leaked owner that destroys its child and frees its buffer in ~Owner
+TEST(InplaceFactory, DebugResetLetsDestructorsCleanUp) {
+  struct Child {
+    int *destroyed;
+    ~Child() { ++*destroyed; }
+  };
+  struct Owner {
+    Arena &arena;
+    Child *child;
+    std::pmr::vector<int> buffer;
+    Owner(Arena &a, int *destroyed) : arena(a), child(a.make<Child>(destroyed)), buffer(64, 0, &a) {}
+    ~Owner() { arena.destroy(child); }
+  };
+
+  int destroyed = 0;
+  Arena arena(1024, ArenaMode::Debug);
+  arena.make<Owner>(arena, &destroyed);
+  const ArenaLeaks leaks = arena.reset();
+  EXPECT_EQ(destroyed, 1);
+  EXPECT_EQ(leaks.objects, 1u);      // Only the owner was leaked
+  EXPECT_EQ(leaks.allocations, 0u);  // Its buffer went back in ~Owner
+  EXPECT_EQ(leaks.bytes, 0u);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();